@@ -33,6 +33,13 @@ namespace argparse
     public:
         ArgumentParser(const std::string &name) : program_name(name) {}
 
+        // "--namespace" and "namespace" name the same argument
+        static std::string key_of(const std::string &name)
+        {
+            const auto first = name.find_first_not_of('-');
+            return first == std::string::npos ? name : name.substr(first);
+        }
+
         void add_description(const std::string &desc)
         {
             description = desc;
@@ -66,7 +73,18 @@ namespace argparse
             Argument &default_value(const std::string &val)
             {
                 default_val = val;
-                parser->defaults[name] = val;
+                parser->defaults[key_of(name)] = val;
+                return *this;
+            }
+
+            Argument &default_value(bool val)
+            {
+                return default_value(std::string(val ? "true" : "false"));
+            }
+
+            // Bare flags already parse as "true"
+            Argument &implicit_value(bool)
+            {
                 return *this;
             }
 
@@ -148,14 +166,14 @@ namespace argparse
 
         bool is_used(const std::string &name) const
         {
-            auto it = used_args.find(name);
+            auto it = used_args.find(key_of(name));
             return it != used_args.end() && it->second;
         }
 
         template <typename T>
         T get(const std::string &name) const
         {
-            auto it = arguments.find(name);
+            auto it = arguments.find(key_of(name));
             if (it != arguments.end() && !it->second.empty())
             {
                 if constexpr (std::is_same_v<T, std::string>)
@@ -168,7 +186,7 @@ namespace argparse
                 }
             }
 
-            auto default_it = defaults.find(name);
+            auto default_it = defaults.find(key_of(name));
             if (default_it != defaults.end())
             {
                 if constexpr (std::is_same_v<T, std::string>)
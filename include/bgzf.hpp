@@ -0,0 +1,64 @@
+// bgzf.hpp — BGZF (blocked gzip) block index, block-parallel inflate and random access
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "obo_scanner.hpp"
+
+// One BGZF member: at most 64 KiB in and out, so any offset in the
+// uncompressed data is one block inflate away.
+struct BgzfBlock
+{
+    std::uint64_t coffset = 0; // start of the gzip member in the file
+    std::uint64_t uoffset = 0; // start of its data in the uncompressed stream
+    std::uint32_t csize = 0;
+    std::uint32_t usize = 0;
+};
+
+// True when the data starts with a gzip member carrying the BGZF "BC" extra field.
+bool is_bgzf(std::string_view compressed);
+
+// Walks the member headers (BSIZE/ISIZE); nothing is inflated.
+// Throws std::runtime_error on a malformed block: one that overruns the
+// file, whose extra field reaches into its trailer, or whose ISIZE is
+// over the 64 KiB BGZF limit.
+std::vector<BgzfBlock> index_bgzf(std::string_view compressed);
+
+// A mapped BGZF file plus its block index. With use_cache, the index is
+// read from the samtools-compatible <path>.gzi when that matches the file,
+// and is otherwise rebuilt from the headers and written there for next
+// time; without it, the .gzi is neither read nor written.
+class BgzfFile
+{
+public:
+    BgzfFile(const std::string &path, bool use_cache); // throws std::runtime_error
+    BgzfFile(BgzfFile &&) noexcept = default;
+    BgzfFile &operator=(BgzfFile &&) noexcept = default;
+
+    std::uint64_t size() const { return blocks_.empty() ? 0 : blocks_.back().uoffset + blocks_.back().usize; }
+    const std::vector<BgzfBlock> &blocks() const { return blocks_; }
+
+    // The compressed bytes, e.g. for cache keys.
+    std::string_view compressed() const { return file_.view(); }
+
+    // Uncompressed bytes [offset, offset + len), clamped to the end.
+    // Only the blocks covering the range are inflated.
+    std::string read(std::uint64_t offset, std::size_t len) const;
+
+    // From offset up to and including the '\n' before the next line that
+    // starts with `header` (e.g. '[' for OBO stanzas, '>' for FASTA
+    // records), or to the end.
+    std::string read_record(std::uint64_t offset, char header) const;
+
+    // The whole stream, with blocks inflated on `threads` workers (0 => all cores).
+    std::string inflate_all(unsigned threads) const;
+
+private:
+    std::size_t block_at(std::uint64_t offset) const; // index of the block holding offset
+    void inflate_block(std::size_t i, char *out) const;
+
+    MappedFile file_;
+    std::vector<BgzfBlock> blocks_;
+};
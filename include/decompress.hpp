@@ -0,0 +1,97 @@
+// decompress.hpp — gzip / xz / zstd inputs inflated on a producer thread into a block ring
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "obo_scanner.hpp"
+
+// Detected from the leading magic bytes, not the file name.
+enum class Codec
+{
+    kNone,
+    kGzip, // also multi-member and BGZF files
+    kXz,
+    kZstd, // needs a build with OBO_HAVE_ZSTD
+};
+
+Codec detect_codec(std::string_view head);
+Codec detect_codec_of(const std::string &path); // reads the first bytes; kNone if unreadable
+
+// One decoder over a whole compressed input.
+class Decoder
+{
+public:
+    virtual ~Decoder() = default;
+    // Fills up to cap bytes; returns 0 only at the end of the input.
+    // Throws std::runtime_error on corrupt data.
+    virtual std::size_t decode(char *out, std::size_t cap) = 0;
+};
+
+// throws std::runtime_error when the codec is unsupported in this build
+std::unique_ptr<Decoder> make_decoder(Codec codec, std::string_view compressed);
+
+// Inflates one compressed file on its own thread into a ring of large
+// blocks, so decoding the next block overlaps parsing the current one.
+class InflateStream
+{
+public:
+    static constexpr std::size_t kBlockBytes = std::size_t{4} << 20;
+    static constexpr std::size_t kRingBlocks = 4;
+
+    explicit InflateStream(const std::string &path); // throws std::runtime_error
+    ~InflateStream();
+
+    InflateStream(const InflateStream &) = delete;
+    InflateStream &operator=(const InflateStream &) = delete;
+
+    // Next decoded block, valid until the following call; empty at the end.
+    // Rethrows a decoder error on the consumer side.
+    std::string_view next();
+
+    // The compressed bytes, e.g. for cache keys.
+    std::string_view compressed() const { return file_.view(); }
+
+private:
+    void produce();
+
+    MappedFile file_;
+    std::unique_ptr<Decoder> decoder_;
+    std::vector<std::unique_ptr<char[]>> blocks_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::size_t> free_;                           // block indices the producer may fill
+    std::deque<std::pair<std::size_t, std::size_t>> filled_; // (block, bytes); bytes 0 => end
+    std::size_t held_ = kRingBlocks;                         // block the consumer is reading
+    bool stop_ = false;
+    std::exception_ptr error_;
+    std::thread producer_;
+};
+
+// for_each_term over a compressed input. A block is parsed up to its last
+// stanza header; the partial stanza after it is carried into the next block.
+template <unsigned Fields = obo_field::kAll, typename Visit>
+void for_each_term(InflateStream &in, Visit &&visit)
+{
+    std::string pending;
+    for (auto block = in.next(); !block.empty(); block = in.next())
+    {
+        const auto cut = block.rfind("\n[");
+        if (cut == std::string_view::npos)
+        {
+            pending.append(block);
+            continue;
+        }
+        pending.append(block.substr(0, cut + 1));
+        for_each_term<Fields>(std::string_view(pending), visit);
+        pending.assign(block.substr(cut + 1));
+    }
+    for_each_term<Fields>(std::string_view(pending), visit);
+}
@@ -0,0 +1,142 @@
+// go_graph.hpp — GO DAG over a term table: CSR parent/child edges + cached closures
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <span>
+#include <vector>
+#include "go_id.hpp"
+#include "term_table.hpp"
+
+// One bit per graph node.
+class NodeSet
+{
+public:
+    explicit NodeSet(std::size_t nodes) : words_((nodes + 63) / 64) {}
+
+    bool test(std::uint32_t n) const { return (words_[n / 64] >> (n % 64)) & 1u; }
+    void set(std::uint32_t n) { words_[n / 64] |= std::uint64_t{1} << (n % 64); }
+    void merge(const NodeSet &other)
+    {
+        for (std::size_t w = 0; w < words_.size(); ++w)
+            words_[w] |= other.words_[w];
+    }
+    std::size_t bytes() const { return words_.size() * sizeof(std::uint64_t); }
+    std::size_t count() const
+    {
+        std::size_t c = 0;
+        for (const auto w : words_)
+            c += static_cast<std::size_t>(__builtin_popcountll(w));
+        return c;
+    }
+
+    // Calls f(node) for every member in ascending order.
+    template <typename F>
+    void for_each(F &&f) const
+    {
+        for (std::size_t w = 0; w < words_.size(); ++w)
+            for (std::uint64_t bits = words_[w]; bits; bits &= bits - 1)
+                f(static_cast<std::uint32_t>(w * 64 + __builtin_ctzll(bits)));
+    }
+
+private:
+    std::vector<std::uint64_t> words_;
+};
+
+// Nodes are the table's rows; edges come from is_a and part_of. alt_id
+// values resolve to the node that lists them. Edges to IDs outside the
+// table are dropped.
+class GoGraph
+{
+public:
+    // Edge types; closure queries take a mask of these.
+    enum Relation : std::uint8_t
+    {
+        kIsA = 1u << 0,
+        kPartOf = 1u << 1,
+    };
+    static constexpr unsigned kAnyRelation = kIsA | kPartOf;
+    static constexpr std::uint32_t kNoNode = 0xFFFFFFFFu;
+
+    explicit GoGraph(const TermTableView &table);
+
+    std::size_t size() const { return ids_.size(); }
+
+    // kNoNode when id is neither a primary nor an alt_id in the table.
+    std::uint32_t node(GoId id) const
+    {
+        return id.valid() && id.number() < index_.size() ? index_[id.number()] : kNoNode;
+    }
+    GoId id(std::uint32_t n) const { return ids_[n]; }
+    bool is_obsolete(std::uint32_t n) const { return obsolete_[n]; }
+
+    // Direct edges; relations()[k] types the edge to nodes()[k].
+    std::span<const std::uint32_t> parents(std::uint32_t n) const { return parents_.nodes(n); }
+    std::span<const std::uint8_t> parent_relations(std::uint32_t n) const { return parents_.relations(n); }
+    std::span<const std::uint32_t> children(std::uint32_t n) const { return children_.nodes(n); }
+    std::span<const std::uint8_t> child_relations(std::uint32_t n) const { return children_.relations(n); }
+
+    // Transitive closures (the node itself excluded unless it is on a cycle). Each one is computed
+    // on first use and cached until kClosureCacheBytes is used up, so
+    // repeated queries are a lookup; a walk stops at any node whose closure
+    // is already cached. Safe to call from several threads: lookups and
+    // walks share a reader lock, and only storing a new closure is exclusive.
+    static constexpr std::size_t kClosureCacheBytes = std::size_t{256} << 20;
+    std::shared_ptr<const NodeSet> ancestors(std::uint32_t n, unsigned relations = kAnyRelation) const;
+    std::shared_ptr<const NodeSet> descendants(std::uint32_t n, unsigned relations = kAnyRelation) const;
+    bool is_ancestor(std::uint32_t ancestor, std::uint32_t n, unsigned relations = kAnyRelation) const
+    {
+        return ancestors(n, relations)->test(ancestor);
+    }
+
+    // Longest is_a/part_of path to a root (roots are 0). Nodes on a cycle,
+    // which a well-formed release never has, report 0.
+    unsigned depth(std::uint32_t n) const { return depth_[n]; }
+
+    // Closest non-obsolete term reachable over parent edges (fewest hops,
+    // ties to the earlier edge), or the term itself when it is live.
+    // Precomputed, so this is two array reads. Invalid when none exists.
+    GoId nearest_live_ancestor(GoId id) const
+    {
+        const auto n = node(id);
+        return n == kNoNode || live_[n] == kNoNode ? GoId{} : ids_[live_[n]];
+    }
+
+private:
+    struct Csr
+    {
+        std::vector<std::uint32_t> offsets;
+        std::vector<std::uint32_t> targets;
+        std::vector<std::uint8_t> relation;
+
+        std::span<const std::uint32_t> nodes(std::uint32_t n) const
+        {
+            return {targets.data() + offsets[n], targets.data() + offsets[n + 1]};
+        }
+        std::span<const std::uint8_t> relations(std::uint32_t n) const
+        {
+            return {relation.data() + offsets[n], relation.data() + offsets[n + 1]};
+        }
+    };
+
+    // Cached closures for one direction, one slot per relation mask.
+    using ClosureCache = std::vector<std::shared_ptr<const NodeSet>>;
+
+    std::shared_ptr<const NodeSet> closure(const Csr &edges, ClosureCache *cache, std::uint32_t n, unsigned relations) const;
+    void compute_depths();
+    void compute_live_ancestors();
+
+    std::vector<GoId> ids_;
+    std::vector<bool> obsolete_;
+    std::vector<std::uint32_t> index_; // GoId::number() -> node
+    Csr parents_, children_;
+    std::vector<unsigned> depth_;
+    std::vector<std::uint32_t> live_;
+
+    mutable std::shared_mutex cache_mutex_;
+    mutable std::size_t cached_bytes_ = 0;
+    mutable ClosureCache ancestor_cache_[kAnyRelation];
+    mutable ClosureCache descendant_cache_[kAnyRelation];
+};
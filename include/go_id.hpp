@@ -0,0 +1,97 @@
+// go_id.hpp — 4-byte GO identifier ("GO:" + 7 digits) with parse/format helpers
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+// Stores only the 7-digit number, so IDs hash, compare and sort as integers.
+// A default-constructed GoId is invalid and formats as an empty string.
+class GoId
+{
+public:
+    static constexpr std::uint32_t kMaxNumber = 9999999;
+    static constexpr std::size_t kTextSize = 10; // "GO:0048308"
+
+    constexpr GoId() = default;
+    constexpr explicit GoId(std::uint32_t number) : value_(number <= kMaxNumber ? number : kInvalid) {}
+
+    // Accepts exactly "GO:" followed by 7 digits; anything else yields an invalid id.
+    static constexpr GoId parse(std::string_view s)
+    {
+        if (s.size() != kTextSize || s[0] != 'G' || s[1] != 'O' || s[2] != ':')
+            return GoId{};
+        std::uint32_t n = 0;
+        for (std::size_t i = 3; i < kTextSize; ++i)
+        {
+            const char c = s[i];
+            if (c < '0' || c > '9')
+                return GoId{};
+            n = n * 10 + static_cast<std::uint32_t>(c - '0');
+        }
+        return GoId{n};
+    }
+
+    constexpr bool valid() const { return value_ != kInvalid; }
+    constexpr explicit operator bool() const { return valid(); }
+    constexpr std::uint32_t number() const { return value_; }
+
+    // Writes "GO:nnnnnnn" (nothing for an invalid id); returns one past the last byte written.
+    char *format(char *out) const
+    {
+        if (!valid())
+            return out;
+        out[0] = 'G';
+        out[1] = 'O';
+        out[2] = ':';
+        std::uint32_t n = value_;
+        for (std::size_t i = kTextSize; i-- > 3;)
+        {
+            out[i] = static_cast<char>('0' + n % 10);
+            n /= 10;
+        }
+        return out + kTextSize;
+    }
+
+    std::string str() const
+    {
+        char buf[kTextSize];
+        return std::string(buf, format(buf));
+    }
+
+    friend constexpr bool operator==(GoId a, GoId b) { return a.value_ == b.value_; }
+    friend constexpr bool operator!=(GoId a, GoId b) { return a.value_ != b.value_; }
+    friend constexpr bool operator<(GoId a, GoId b) { return a.value_ < b.value_; }
+
+    // Textual comparison without formatting; an invalid id equals "".
+    friend constexpr bool operator==(GoId a, std::string_view s) { return a.valid() ? parse(s) == a : s.empty(); }
+    friend constexpr bool operator==(std::string_view s, GoId a) { return a == s; }
+    friend constexpr bool operator!=(GoId a, std::string_view s) { return !(a == s); }
+    friend constexpr bool operator!=(std::string_view s, GoId a) { return !(a == s); }
+
+    friend std::ostream &operator<<(std::ostream &os, GoId id)
+    {
+        char buf[kTextSize];
+        return os.write(buf, id.format(buf) - buf);
+    }
+
+private:
+    static constexpr std::uint32_t kInvalid = 0xFFFFFFFFu;
+    std::uint32_t value_ = kInvalid;
+};
+
+static_assert(sizeof(GoId) == 4, "GoId must stay a 4-byte value type");
+
+namespace std
+{
+    template <>
+    struct hash<GoId>
+    {
+        size_t operator()(GoId id) const noexcept
+        {
+            // Fibonacci mix so sequential ids spread across buckets
+            return static_cast<size_t>(id.number() * 0x9E3779B97F4A7C15ull >> 16);
+        }
+    };
+} // namespace std
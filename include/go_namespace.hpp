@@ -0,0 +1,48 @@
+// go_namespace.hpp — dense index for the three GO namespaces
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+enum class GoNamespace : std::uint8_t
+{
+    kBiologicalProcess,
+    kMolecularFunction,
+    kCellularComponent,
+    kOther, // empty or any other value
+};
+
+inline constexpr std::size_t kGoNamespaces = 3; // excluding kOther
+
+inline constexpr std::string_view kGoNamespaceNames[kGoNamespaces] = {
+    "biological_process",
+    "molecular_function",
+    "cellular_component",
+};
+
+// All three names are 18 bytes and differ in the first one, so this is a
+// length test, a switch and at most one compare.
+constexpr GoNamespace classify_namespace(std::string_view ns)
+{
+    if (ns.size() != 18)
+        return GoNamespace::kOther;
+    GoNamespace k;
+    switch (ns.front())
+    {
+    case 'b':
+        k = GoNamespace::kBiologicalProcess;
+        break;
+    case 'm':
+        k = GoNamespace::kMolecularFunction;
+        break;
+    case 'c':
+        k = GoNamespace::kCellularComponent;
+        break;
+    default:
+        return GoNamespace::kOther;
+    }
+    return ns == kGoNamespaceNames[static_cast<std::size_t>(k)] ? k : GoNamespace::kOther;
+}
+
+static_assert(classify_namespace("molecular_function") == GoNamespace::kMolecularFunction);
+static_assert(classify_namespace("cellular_componenT") == GoNamespace::kOther);
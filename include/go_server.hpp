@@ -0,0 +1,88 @@
+// go_server.hpp — --serve: releases loaded once, queried over a Unix domain socket
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "go_graph.hpp"
+#include "obo_engine.hpp"
+#include "replacement_resolver.hpp"
+
+// Line protocol, one request per line:
+//   PING
+//   LOOKUP GO:nnnnnnn     id, name, namespace, live|obsolete, replaced_by=...;consider=...
+//   RESOLVE GO:nnnnnnn    as task2 --resolve-replacements
+//   ANCESTORS GO:nnnnnnn [relation=is_a|part_of]    id, depth per line, ascending IDs
+//   DESCENDANTS GO:nnnnnnn [relation=is_a|part_of]  (default: both relations)
+//   CONSIDER [namespace=NS[,NS...]] [pattern=REGEX]
+//   STATS [namespace=NS[,NS...]] [pattern=REGEX]
+//   QUIT
+// pattern= takes the rest of the line, so it comes last. Each reply is
+// "OK <n>" followed by n tab-separated lines, or one "ERR <message>" line.
+//
+// The loaded releases are an immutable snapshot published through an
+// atomic shared_ptr. A request pins the current snapshot for its duration;
+// reload() builds a new one off to the side and swaps it in, so requests
+// never wait on a rebuild, and an old snapshot is freed (unmapping its
+// .gocache files) when the last request holding it finishes.
+class GoServer
+{
+public:
+    // Loads the tables as scan_obo_files would (throws std::runtime_error).
+    GoServer(const std::vector<std::string> &obo_files, unsigned threads, bool use_cache);
+
+    // Appends the reply to one request line; false once the client sent QUIT.
+    bool handle(std::string_view request, std::string &reply) const;
+
+    // Re-reads every input and publishes the result. On failure the
+    // current snapshot stays in place and the error is rethrown.
+    void reload();
+
+    // Binds socket_path (replacing a stale socket left there) and answers
+    // requests on `workers` threads (0 => all cores) until SIGINT or
+    // SIGTERM. One thread polls every connection and hands complete request
+    // lines to the workers, so idle connections hold no worker. A line over
+    // kMaxRequestBytes gets "ERR ..." and the connection is closed; a client
+    // that stops reading its replies is dropped after kSendTimeoutMs.
+    // Meanwhile the inputs' directories are watched with inotify, and once a
+    // changed input has been quiet for kReloadQuietMs it is reloaded in the
+    // background. Throws std::runtime_error when the socket cannot be set up.
+    static constexpr int kReloadQuietMs = 500;
+    static constexpr std::size_t kMaxRequestBytes = std::size_t{64} << 10;
+    static constexpr int kSendTimeoutMs = 10'000;
+    void serve(const std::string &socket_path, unsigned workers);
+
+private:
+    struct Row
+    {
+        std::uint32_t table = 0xFFFFFFFFu;
+        std::uint32_t row = 0;
+    };
+
+    // One generation of loaded releases; never modified once published
+    // (apart from the graphs' internally locked closure caches).
+    struct Snapshot
+    {
+        Snapshot(const std::vector<std::string> &obo_files, unsigned threads, bool use_cache);
+
+        const Row *find(GoId id) const
+        {
+            return id.valid() && id.number() < index.size() && index[id.number()].table != 0xFFFFFFFFu ? &index[id.number()] : nullptr;
+        }
+
+        TermTables tables;
+        ReplacementResolver resolver;
+        std::vector<std::unique_ptr<const GoGraph>> graphs; // per table; closures cached across requests
+        std::vector<Row> index; // GoId::number() -> first row listing it (alt_ids included)
+    };
+
+    void watch_inputs(int inotify_fd); // reload loop; returns on stop
+
+    std::vector<std::string> obo_files_;
+    unsigned threads_;
+    bool use_cache_;
+    std::atomic<std::shared_ptr<const Snapshot>> snapshot_;
+};
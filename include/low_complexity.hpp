@@ -0,0 +1,164 @@
+// low_complexity.hpp — residues in low-complexity stretches: DUST for nucleotides, SEG's trigger for proteins
+// One pass per sequence, a window at a time; nothing is allocated.
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace low_complexity
+{
+    // DUST (dustmasker defaults): windows of 64 bases, 32 apart. In each,
+    // the sub-interval with the best triplet score sum c_t(c_t - 1)/2 /
+    // (l - 1), over its l triplets, is low complexity when that score is
+    // above 20. Triplets holding anything but A/C/G/T/U never repeat.
+    constexpr std::size_t kDustWindow = 64;
+    constexpr std::size_t kDustStep = 32;
+    constexpr std::uint64_t kDustLevel = 20;
+
+    // SEG's trigger window: 12 residues with under 2.2 bits of Shannon
+    // entropy over their case-folded bytes.
+    constexpr std::size_t kSegWindow = 12;
+    constexpr double kSegBits = 2.2;
+
+    // Marks in mask (bit i: base i of the window) the bases of the
+    // best-scoring sub-interval of triplets t[0, n) when it is over the level.
+    inline void mark_dust_interval(const std::uint8_t *t, std::size_t n, std::uint64_t &mask)
+    {
+        // A sub-interval scores above the level only with l > 2 * level
+        // (pairs <= l(l - 1)/2), so with over 2 * level^2 pairs; it never
+        // holds more pairs than the window. Most windows stop here.
+        std::array<std::uint8_t, 65> count{}; // slot 64: triplets that never repeat
+        std::uint64_t pairs = 0;
+        for (std::size_t i = 0; i < n; ++i)
+            pairs += t[i] < 64 ? count[t[i]]++ : 0;
+        if (pairs <= 2 * kDustLevel * kDustLevel)
+            return;
+
+        // Best pairs / (l - 1) over every sub-interval, compared as fractions.
+        std::uint64_t best_pairs = 0, best_div = 1;
+        std::size_t best_from = 0, best_to = 0; // triplets [from, to]
+        for (std::size_t from = 0; from + 1 < n; ++from)
+        {
+            count.fill(0);
+            pairs = 0;
+            ++count[t[from]];
+            for (std::size_t to = from + 1; to < n; ++to)
+            {
+                pairs += t[to] < 64 ? count[t[to]] : 0;
+                ++count[t[to]];
+                const std::uint64_t div = to - from; // l - 1
+                if (pairs * best_div > best_pairs * div)
+                {
+                    best_pairs = pairs, best_div = div;
+                    best_from = from, best_to = to;
+                }
+            }
+        }
+        if (best_pairs > kDustLevel * best_div)
+        { // bases [from, to + 3)
+            const std::size_t bits = best_to + 3 - best_from;
+            mask |= (bits == 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << bits) - 1) << best_from;
+        }
+    }
+
+    // Residues of s inside a low-scoring DUST interval.
+    inline std::uint64_t count_dust(std::string_view s)
+    {
+        static_assert(kDustWindow == 64 && kDustStep == 32, "one 64-bit mask per window, finished a half at a time");
+        static constexpr auto kBase = []
+        {
+            std::array<std::uint8_t, 256> t{};
+            t.fill(4);
+            constexpr std::string_view bases = "ACGTU"; // U codes as T
+            for (std::size_t i = 0; i < bases.size(); ++i)
+                t[static_cast<unsigned char>(bases[i])] = t[static_cast<unsigned char>(bases[i] | 0x20)] =
+                    static_cast<std::uint8_t>(i < 4 ? i : 3);
+            return t;
+        }();
+
+        std::uint64_t low = 0;
+        std::uint64_t mask = 0; // bit i: base w + i is low complexity
+        for (std::size_t w = 0; w + 3 <= s.size(); w += kDustStep)
+        {
+            const std::size_t end = std::min(w + kDustWindow, s.size());
+            const std::size_t n = end - w - 2; // triplets in the window
+            std::array<std::uint8_t, kDustWindow> t;
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                const unsigned a = kBase[static_cast<unsigned char>(s[w + i])];
+                const unsigned b = kBase[static_cast<unsigned char>(s[w + i + 1])];
+                const unsigned c = kBase[static_cast<unsigned char>(s[w + i + 2])];
+                t[i] = static_cast<std::uint8_t>((a | b | c) > 3 ? 64 : a << 4 | b << 2 | c);
+            }
+            mark_dust_interval(t.data(), n, mask);
+            if (end == s.size())
+                break;
+            low += static_cast<std::uint64_t>(std::popcount(mask & 0xFFFFFFFFu)); // no later window reaches these
+            mask >>= kDustStep;
+        }
+        return low + static_cast<std::uint64_t>(std::popcount(mask));
+    }
+
+    // Length of the union of equal-length windows, which arrive in order.
+    struct Cover
+    {
+        std::uint64_t count = 0;
+        std::size_t until = 0; // end of the last low window
+
+        void add(std::size_t begin, std::size_t end)
+        {
+            count += end - (until > begin ? until : begin);
+            until = end;
+        }
+    };
+
+    // Residues of s inside at least one SEG trigger window; a sequence
+    // shorter than the window is scored as one window.
+    inline std::uint64_t count_seg(std::string_view s)
+    {
+        if (s.empty())
+            return 0;
+        const std::size_t window = s.size() < kSegWindow ? s.size() : kSegWindow;
+        // H = log2(n) - sum c log2 c / n, so H < bits <=> sum c log2 c > n (log2 n - bits).
+        // Fixed point (2^32), so the running sum never drifts as the window moves.
+        auto fixed = [](double x)
+        { return static_cast<std::int64_t>(std::llround(std::ldexp(x, 32))); };
+        std::array<std::int64_t, kSegWindow + 1> clog{};
+        for (std::size_t k = 1; k <= window; ++k)
+            clog[k] = fixed(double(k) * std::log2(double(k)));
+        const std::int64_t limit = fixed(double(window) * (std::log2(double(window)) - kSegBits));
+
+        std::array<std::uint8_t, 256> c{};
+        std::int64_t sum = 0;
+        auto fold = [](char ch)
+        { return static_cast<unsigned char>(ch >= 'a' && ch <= 'z' ? ch - 0x20 : ch); };
+        auto add = [&](unsigned char b)
+        {
+            sum += clog[c[b] + 1] - clog[c[b]];
+            ++c[b];
+        };
+        auto drop = [&](unsigned char b)
+        {
+            sum -= clog[c[b]] - clog[c[b] - 1];
+            --c[b];
+        };
+
+        Cover cover;
+        for (std::size_t i = 0; i < window; ++i)
+            add(fold(s[i]));
+        for (std::size_t w = 0;; ++w)
+        { // window [w, w + window)
+            if (sum > limit)
+                cover.add(w, w + window);
+            if (w + window == s.size())
+                break;
+            drop(fold(s[w]));
+            add(fold(s[w + window]));
+        }
+        return cover.count;
+    }
+} // namespace low_complexity
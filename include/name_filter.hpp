@@ -0,0 +1,32 @@
+// name_filter.hpp — --pattern matcher: required-literal prefilter in front of std::regex
+#pragma once
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Literal runs every match of an ECMAScript pattern must contain, longest
+// first ("ribosome" for ".*ribosome.*"). Conservative: anything the
+// extractor does not understand (groups, classes, most escapes) just ends
+// the current run, and a top-level '|' yields no literals at all.
+std::vector<std::string> required_literals(std::string_view pattern);
+
+// Matches term names like std::regex_search, but rejects names that lack
+// one of the required literals before the regex ever runs.
+class NameFilter
+{
+public:
+    // throws std::regex_error for an invalid pattern
+    explicit NameFilter(const std::string &pattern,
+                        std::regex::flag_type flags = std::regex::ECMAScript);
+
+    bool matches(std::string_view name) const;
+
+    const std::string &pattern() const { return pattern_; }
+    const std::vector<std::string> &literals() const { return literals_; }
+
+private:
+    std::string pattern_;
+    std::regex re_;
+    std::vector<std::string> literals_; // empty => every name goes to the regex
+};
@@ -0,0 +1,59 @@
+// obo_engine.hpp — single-pass stanza visitor shared by consider-table and obsolete-stats
+#pragma once
+#include <map>
+#include <span>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "task2_utils.hpp"
+#include "term_table.hpp"
+#include "task3_utils.hpp"
+
+// What a pass should produce; combine with |.
+enum ScanOutput : unsigned
+{
+    kConsiderRows = 1u << 0,
+    kObsoleteStats = 1u << 1,
+};
+
+struct ScanResult
+{
+    std::vector<ConsiderRow> consider_rows;               // filled for kConsiderRows
+    std::map<std::string, NamespaceStats> obsolete_stats; // filled for kObsoleteStats
+};
+
+// Reads every input once (chunked, on `threads` workers) and applies the
+// namespace/name filters to each obsolete [Term] before handing it to the
+// requested outputs. Results are merged in file/offset order.
+// With use_cache, each input is read from its .gocache snapshot when that is
+// fresh, and parsed once and snapshotted when it is not.
+ScanResult scan_obo_files(
+    const std::vector<std::string> &obo_files,
+    const std::unordered_set<std::string> &ns_filter, // empty => all
+    const NameFilter *name_filter,                    // nullptr => no filter
+    unsigned outputs,                                 // ScanOutput bits
+    unsigned threads = 1,                             // 0 => all cores
+    bool use_cache = false);
+
+// Term tables for a set of inputs. A view is backed by a mapped .gocache
+// snapshot or by a freshly parsed builder, so it lives as long as this.
+struct TermTables
+{
+    std::vector<TermCache> caches;
+    std::vector<TermTableBuilder> built;
+    std::vector<TermTableView> views; // one per input, in input order
+};
+
+// Maps each input's fresh snapshot, and parses the rest in parallel
+// chunks. With use_cache, missing or stale snapshots are (re)written;
+// without it, snapshots are neither read nor written.
+TermTables load_term_tables(const std::vector<std::string> &obo_files, unsigned threads, bool use_cache);
+
+// scan_obo_files over tables that are already loaded: filters run on the
+// columns, and only matching rows are materialised.
+ScanResult scan_term_tables(
+    std::span<const TermTableView> views,
+    const std::unordered_set<std::string> &ns_filter, // empty => all
+    const NameFilter *name_filter,                    // nullptr => no filter
+    unsigned outputs,                                 // ScanOutput bits
+    unsigned threads = 1);                            // 0 => all cores
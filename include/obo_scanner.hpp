@@ -0,0 +1,277 @@
+// obo_scanner.hpp — zero-copy [Term] stanza scanner over memory-mapped OBO files
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "go_id.hpp"
+#include "scratch_arena.hpp"
+#include "simd_scan.hpp"
+
+// Read-only mapping of a whole file. Empty files map to an empty view.
+class MappedFile
+{
+public:
+    MappedFile() = default; // maps nothing
+    explicit MappedFile(const std::string &path); // throws std::runtime_error
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+
+    std::string_view view() const { return {data_, size_}; }
+
+private:
+    const char *data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+// Writes parts, in order, to a fresh mkstemp file next to path and renames
+// it over path, so concurrent writers never share a temp file and readers
+// see the old file or the whole new one. False on I/O failure, with the
+// temp file removed.
+bool replace_file(const std::string &path, std::span<const std::string_view> parts);
+
+// Tags the scanner understands. Scanners take a mask of these as a template
+// parameter and never look at the value of a tag outside the mask.
+namespace obo_field
+{
+    inline constexpr unsigned kId = 1u << 0;
+    inline constexpr unsigned kName = 1u << 1;
+    inline constexpr unsigned kNamespace = 1u << 2;
+    inline constexpr unsigned kIsObsolete = 1u << 3;
+    inline constexpr unsigned kConsider = 1u << 4;
+    inline constexpr unsigned kReplacedBy = 1u << 5;
+    inline constexpr unsigned kAltId = 1u << 6;
+    inline constexpr unsigned kIsA = 1u << 7;
+    inline constexpr unsigned kRelationship = 1u << 8; // only part_of is kept
+    inline constexpr unsigned kXref = 1u << 9;
+    inline constexpr unsigned kAll = (1u << 10) - 1;
+} // namespace obo_field
+
+// One [Term] stanza. Text views point into the scanned buffer; the vectors
+// are reused between stanzas, so nothing here outlives the visit callback.
+// Fields outside the scanner's mask stay empty, and ID-valued tags whose
+// value is not a GO ID are dropped.
+struct OboTerm
+{
+    OboTerm() = default;
+    // Vectors draw from mr, typically a ScratchArena that lives as long as the scan.
+    explicit OboTerm(std::pmr::memory_resource *mr)
+        : consider(mr), replaced_by(mr), alt_id(mr), is_a(mr), part_of(mr), xref(mr) {}
+
+    GoId id;
+    std::string_view name;
+    std::string_view ns;
+    bool is_obsolete = false;
+    std::pmr::vector<GoId> consider;
+    std::pmr::vector<GoId> replaced_by;
+    std::pmr::vector<GoId> alt_id;
+    std::pmr::vector<GoId> is_a;
+    std::pmr::vector<GoId> part_of; // relationship: part_of
+    std::pmr::vector<std::string_view> xref;
+
+    void clear()
+    {
+        id = GoId{};
+        name = ns = {};
+        is_obsolete = false;
+        consider.clear();
+        replaced_by.clear();
+        alt_id.clear();
+        is_a.clear();
+        part_of.clear();
+        xref.clear();
+    }
+};
+
+namespace obo_detail
+{
+    inline std::string_view trim(std::string_view s)
+    {
+        while (!s.empty() && (s.front() == ' ' || s.front() == '\t'))
+            s.remove_prefix(1);
+        while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r'))
+            s.remove_suffix(1);
+        return s;
+    }
+
+    // First whitespace-delimited token, i.e. "GO:0048308" from "GO:0048308 ! organelle inheritance"
+    inline std::string_view first_token(std::string_view s)
+    {
+        const auto end = s.find_first_of(" \t");
+        return end == std::string_view::npos ? s : s.substr(0, end);
+    }
+
+    inline void push_go_id(std::pmr::vector<GoId> &ids, std::string_view value)
+    {
+        if (const auto id = GoId::parse(first_token(value)))
+            ids.push_back(id);
+    }
+
+    struct TagSpec
+    {
+        std::string_view tag;
+        unsigned field;
+    };
+
+    inline constexpr TagSpec kTags[] = {
+        {"id", obo_field::kId},
+        {"name", obo_field::kName},
+        {"namespace", obo_field::kNamespace},
+        {"is_obsolete", obo_field::kIsObsolete},
+        {"consider", obo_field::kConsider},
+        {"replaced_by", obo_field::kReplacedBy},
+        {"alt_id", obo_field::kAltId},
+        {"is_a", obo_field::kIsA},
+        {"relationship", obo_field::kRelationship},
+        {"xref", obo_field::kXref},
+    };
+
+    // Length and first byte are enough to tell the known tags apart.
+    inline constexpr unsigned kTagSlots = 32;
+    constexpr unsigned tag_hash(std::string_view tag)
+    {
+        return (static_cast<unsigned>(tag.size()) * 7u + static_cast<unsigned char>(tag.front())) % kTagSlots;
+    }
+
+    struct TagSlots
+    {
+        TagSpec slot[kTagSlots]{};
+        bool perfect = true;
+    };
+
+    constexpr TagSlots make_tag_slots()
+    {
+        TagSlots t;
+        for (const auto &spec : kTags)
+        {
+            auto &s = t.slot[tag_hash(spec.tag)];
+            if (s.field != 0)
+                t.perfect = false;
+            s = spec;
+        }
+        return t;
+    }
+
+    inline constexpr TagSlots kTagSlotTable = make_tag_slots();
+    static_assert(kTagSlotTable.perfect, "tag_hash collides; adjust the multiplier");
+
+    // Field bit for tag, or 0 when the tag is unknown or not in Fields.
+    // Tags outside Fields are rejected on the slot's field bit alone.
+    template <unsigned Fields>
+    inline unsigned classify_tag(std::string_view tag)
+    {
+        if (tag.empty())
+            return 0;
+        const auto &spec = kTagSlotTable.slot[tag_hash(tag)];
+        if ((spec.field & Fields) == 0 || spec.tag != tag)
+            return 0;
+        return spec.field;
+    }
+
+    template <unsigned Fields>
+    inline void take_tag(OboTerm &t, std::string_view tag, std::string_view value)
+    {
+        switch (classify_tag<Fields>(tag))
+        {
+        case obo_field::kId:
+            t.id = GoId::parse(first_token(value));
+            break;
+        case obo_field::kName:
+            t.name = value;
+            break;
+        case obo_field::kNamespace:
+            t.ns = value;
+            break;
+        case obo_field::kIsObsolete:
+            t.is_obsolete = (value == "true");
+            break;
+        case obo_field::kConsider:
+            push_go_id(t.consider, value);
+            break;
+        case obo_field::kReplacedBy:
+            push_go_id(t.replaced_by, value);
+            break;
+        case obo_field::kAltId:
+            push_go_id(t.alt_id, value);
+            break;
+        case obo_field::kIsA:
+            push_go_id(t.is_a, value);
+            break;
+        case obo_field::kRelationship:
+            if (value.starts_with("part_of "))
+                push_go_id(t.part_of, trim(value.substr(8)));
+            break;
+        case obo_field::kXref:
+            t.xref.push_back(first_token(value));
+            break;
+        default:
+            break;
+        }
+    }
+} // namespace obo_detail
+
+// Splits buf into at most `parts` consecutive ranges. Every range but the
+// first starts on a stanza header ("\n[Term]", "\n[Typedef]", ...), so each
+// one can be handed to for_each_term on its own and the partial results
+// concatenated in range order.
+std::vector<std::string_view> split_at_stanzas(std::string_view buf, std::size_t parts);
+
+// Mapped inputs cut into stanza-aligned chunks, ordered by file then offset.
+struct OboChunkPlan
+{
+    std::vector<MappedFile> files;
+    std::vector<std::string_view> chunks;
+    std::vector<std::size_t> chunk_file; // index into files, per chunk
+};
+
+// Maps every file and sizes the chunks so `threads` workers stay busy;
+// a single worker gets one chunk per file.
+OboChunkPlan plan_obo_chunks(const std::vector<std::string> &paths, unsigned threads);
+
+// Inline scratch for the stanza record: a few hundred GO IDs before the
+// arena touches the heap.
+inline constexpr std::size_t kStanzaScratchBytes = 4096;
+
+// Walks every [Term] stanza in buf and calls visit(const OboTerm &) once per stanza,
+// filling only the obo_field bits in Fields. Other stanza types ([Typedef],
+// [Instance]) and the header block are skipped.
+template <unsigned Fields = obo_field::kAll, typename Visit>
+void for_each_term(std::string_view buf, Visit &&visit)
+{
+    // The vectors keep their capacity across stanzas, so once the first
+    // few stanzas have sized them a chunk allocates nothing per term.
+    ScratchArena<kStanzaScratchBytes> arena;
+    OboTerm term(arena.resource());
+    bool in_term = false;
+    simd_scan::LineScanner lines(buf);
+    std::string_view line;
+    std::size_t colon;
+
+    while (lines.next(line, colon))
+    {
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+        if (line.empty())
+            continue;
+
+        if (line.front() == '[')
+        {
+            if (in_term)
+                visit(static_cast<const OboTerm &>(term));
+            in_term = (line == "[Term]");
+            term.clear();
+            continue;
+        }
+        if (!in_term || colon >= line.size())
+            continue;
+        obo_detail::take_tag<Fields>(term, line.substr(0, colon), obo_detail::trim(line.substr(colon + 1)));
+    }
+    if (in_term)
+        visit(static_cast<const OboTerm &>(term));
+}
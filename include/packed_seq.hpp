@@ -0,0 +1,67 @@
+// packed_seq.hpp — 2-bit (ACGT) / 5-bit (amino acid) sequence storage with search on the packed codes
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// One sequence held as fixed-width codes in 64-bit words: 2 bits per base
+// (ACGT, 32 per word) or 5 bits per residue (A-Z, '*', '-', 12 per word).
+// Bytes the alphabet has no code for (N and other IUPAC codes in DNA,
+// anything else in protein) are kept as runs in an exception list, and
+// lowercase (soft-masked) stretches as runs in a mask list, so unpack()
+// gives back the input byte for byte. pack() takes whichever encoding is
+// smaller for the record, exceptions included.
+class PackedSeq
+{
+public:
+    enum class Alphabet : std::uint8_t
+    {
+        Nucleotide, // 2 bits per base
+        Protein,    // 5 bits per residue
+    };
+
+    static PackedSeq pack(std::string_view seq);
+
+    std::size_t size() const { return size_; }
+    Alphabet alphabet() const { return alphabet_; }
+
+    // Heap bytes held (codes plus both run lists).
+    std::size_t packed_bytes() const;
+
+    // Appends bytes [begin, end), clamped to size(), to out.
+    void unpack(std::size_t begin, std::size_t end, std::string &out) const;
+    std::string unpack() const;
+
+    // First occurrence of pattern at or after from, npos if none; the same
+    // answer as unpack().find(pattern, from). An uppercase pattern the
+    // alphabet can encode is compared a word of codes at a time, skipping
+    // the exception and mask runs; any other pattern is unpacked and searched.
+    std::size_t find(std::string_view pattern, std::size_t from = 0) const;
+
+private:
+    // Bytes [begin, begin + length) are all `byte` (exceptions) or all
+    // lowercase (mask, byte unused). Sorted and non-overlapping per list.
+    struct Run
+    {
+        std::uint64_t begin = 0;
+        std::uint32_t length = 0;
+        char byte = 0;
+
+        std::uint64_t end() const { return begin + length; }
+    };
+
+    unsigned bits() const { return alphabet_ == Alphabet::Nucleotide ? 2 : 5; }
+    unsigned per_word() const { return alphabet_ == Alphabet::Nucleotide ? 32 : 12; }
+    template <unsigned Bits>
+    std::uint64_t codes_at(std::size_t i) const; // the 64 / Bits codes starting at residue i
+    template <unsigned Bits>
+    std::size_t find_codes(std::string_view pattern, std::size_t from) const;
+
+    std::vector<std::uint64_t> words_;
+    std::vector<Run> exceptions_;
+    std::vector<Run> lower_;
+    std::size_t size_ = 0;
+    Alphabet alphabet_ = Alphabet::Nucleotide;
+};
@@ -0,0 +1,54 @@
+// release_diff.hpp — obsolescence changes between consecutive GO releases
+#pragma once
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+#include "go_id.hpp"
+#include "name_filter.hpp"
+#include "tab_writer.hpp"
+
+enum class ChangeKind
+{
+    kObsoleted,           // live (or new) in `to`, obsolete there but not in `from`
+    kRevived,             // obsolete in `from`, live in `to`
+    kAlternativesChanged, // obsolete in both, consider/replaced_by targets differ
+    kNamespaceMoved,      // namespace differs
+};
+
+const char *change_kind_name(ChangeKind kind);
+
+// One change for one term between two neighbouring releases. Views point
+// into the two loaded tables and are valid only inside the callback.
+struct ReleaseChange
+{
+    const std::string *from; // release paths as given
+    const std::string *to;
+    ChangeKind kind;
+    GoId id;
+    std::string_view ns_before, ns_after;
+    std::span<const GoId> replaced_by_before, replaced_by_after;
+    std::span<const GoId> consider_before, consider_after;
+};
+
+// from <tab> to <tab> change <tab> GO:id <tab> before <tab> after <newline>
+// before/after: the namespace for kNamespaceMoved, otherwise
+// "replaced_by=GO:a,GO:b;consider=GO:c" (empty while the term is live).
+void write_release_change(TabWriter &out, const ReleaseChange &c);
+void write_release_change_header(TabWriter &out);
+
+// Walks the releases in the given order and reports every change between
+// each neighbouring pair, pair by pair and by ascending ID within a pair.
+// Each release's table is ID-sorted once and merge-joined with the next,
+// and only the two releases of the current pair are held in memory.
+// Filters apply to the term as it is in the newer release; IDs that are
+// missing from the newer release are not reported.
+void diff_releases(
+    const std::vector<std::string> &releases,
+    const std::unordered_set<std::string> &ns_filter, // empty => all
+    const NameFilter *name_filter,                    // nullptr => no filter
+    unsigned threads,                                 // 0 => all cores
+    bool use_cache,
+    const std::function<void(const ReleaseChange &)> &emit);
@@ -0,0 +1,80 @@
+// replacement_resolver.hpp — final live targets of obsolete terms (replaced_by/consider chains)
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "go_id.hpp"
+#include "tab_writer.hpp"
+#include "term_table.hpp"
+
+enum class Resolution : std::uint8_t
+{
+    kLive,     // not obsolete; resolves to itself
+    kResolved, // obsolete, with at least one live target
+    kDeadEnd,  // obsolete, and every chain stops at an obsolete term with no alternatives
+    kCycle,    // obsolete, and its chains only lead back into themselves
+    kUnknown,  // not in the tables
+};
+
+const char *resolution_name(Resolution r);
+
+// Follows replaced_by, and consider where there is no replaced_by, until
+// live terms are reached. A term's replaced_by wins over its consider list;
+// targets outside the tables are ignored.
+//
+// replaced_by is single-valued, so its chains form a forest that is
+// collapsed with union-find style path compression: every term points at
+// the end of its chain after one pass. consider lists fan out and may loop,
+// so the chain ends are grouped into strongly connected components, and
+// each component takes the union of its targets' results in reverse
+// topological order. Both passes are linear in the number of edges and
+// detect cycles. Queries are then two array reads.
+class ReplacementResolver
+{
+public:
+    // The first table that lists an ID wins; alt_id values resolve like
+    // the primary ID that lists them.
+    explicit ReplacementResolver(std::span<const TermTableView> tables);
+
+    Resolution status(GoId id) const
+    {
+        const auto n = node(id);
+        return n == kNoNode ? Resolution::kUnknown : status_[n];
+    }
+
+    // Live terms id resolves to, ascending: id itself when it is live,
+    // empty unless the status is kLive or kResolved.
+    std::span<const GoId> targets(GoId id) const
+    {
+        const auto n = node(id);
+        if (n == kNoNode)
+            return {};
+        const auto r = root_[n];
+        return r == kNoNode ? std::span<const GoId>{} : std::span<const GoId>{targets_.data() + offsets_[r], targets_.data() + offsets_[r + 1]};
+    }
+
+private:
+    static constexpr std::uint32_t kNoNode = 0xFFFFFFFFu;
+
+    std::uint32_t node(GoId id) const
+    {
+        return id.valid() && id.number() < index_.size() ? index_[id.number()] : kNoNode;
+    }
+    void compress_replaced_by();
+    void expand_consider();
+
+    std::vector<std::uint32_t> index_; // GoId::number() -> node
+    std::vector<GoId> ids_;
+    std::vector<bool> obsolete_;
+    std::vector<std::uint32_t> next_;             // replaced_by successor, or the node itself
+    std::vector<std::uint32_t> consider_offsets_; // node -> consider successors (CSR)
+    std::vector<std::uint32_t> consider_;
+
+    std::vector<std::uint32_t> root_; // end of the replaced_by chain; kNoNode on a cycle
+    std::vector<Resolution> status_;
+    std::vector<std::uint32_t> offsets_; // chain end -> live targets (CSR)
+    std::vector<GoId> targets_;
+};
+
+// GO:obsolete_id <tab> status <tab> GO:live,GO:live <newline>
+void write_resolution_row(TabWriter &out, GoId id, Resolution status, std::span<const GoId> targets);
@@ -0,0 +1,178 @@
+// residue_counts.hpp — case-folded A-Z byte histogram for sequence composition
+// AVX2 is picked at runtime when the CPU has it; otherwise a scalar table.
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define RESIDUE_COUNTS_X86 1
+#else
+#define RESIDUE_COUNTS_X86 0
+#endif
+
+namespace residue_counts
+{
+    // Letters are counted case-insensitively; lowercase (soft-masked)
+    // letters are also counted on their own. Anything else is only in total.
+    struct Counts
+    {
+        std::array<std::uint64_t, 26> letter{}; // 'A'/'a' .. 'Z'/'z'
+        std::uint64_t lowercase = 0;
+        std::uint64_t low_complexity = 0; // set by the caller (low_complexity.hpp); the kernels leave it
+        std::uint64_t total = 0;
+
+        std::uint64_t operator[](char upper) const { return letter[static_cast<std::size_t>(upper - 'A')]; }
+
+        // At least 90% of the letters are A/C/G/T/U/N.
+        bool nucleotide() const
+        {
+            std::uint64_t letters = 0;
+            for (const auto n : letter)
+                letters += n;
+            const auto nucleotides = (*this)['A'] + (*this)['C'] + (*this)['G'] + (*this)['T'] + (*this)['U'] + (*this)['N'];
+            return letters > 0 && nucleotides * 10 >= letters * 9;
+        }
+
+        Counts &operator+=(const Counts &o)
+        {
+            for (std::size_t i = 0; i < letter.size(); ++i)
+                letter[i] += o.letter[i];
+            lowercase += o.lowercase;
+            low_complexity += o.low_complexity;
+            total += o.total;
+            return *this;
+        }
+    };
+
+    // Byte at a time, for short inputs and vector tails.
+    inline void count_small(std::string_view s, Counts &out)
+    {
+        for (const char ch : s)
+        {
+            const auto c = static_cast<unsigned char>(ch);
+            const unsigned k = (c | 0x20u) - 'a';
+            if (k < 26)
+            {
+                ++out.letter[k];
+                out.lowercase += c >= 'a';
+            }
+        }
+        out.total += s.size();
+    }
+
+    // Four interleaved tables so neighbouring equal bytes do not wait on
+    // each other's increment.
+    inline void count_scalar(std::string_view s, Counts &out)
+    {
+        if (s.size() < 4096)
+            return count_small(s, out); // not worth clearing the tables
+        std::array<std::array<std::uint64_t, 256>, 4> t{};
+        std::size_t i = 0;
+        for (; i + 4 <= s.size(); i += 4)
+        {
+            ++t[0][static_cast<unsigned char>(s[i])];
+            ++t[1][static_cast<unsigned char>(s[i + 1])];
+            ++t[2][static_cast<unsigned char>(s[i + 2])];
+            ++t[3][static_cast<unsigned char>(s[i + 3])];
+        }
+        for (; i < s.size(); ++i)
+            ++t[0][static_cast<unsigned char>(s[i])];
+        for (std::size_t c = 0; c < 26; ++c)
+        {
+            for (const auto &row : t)
+            {
+                out.letter[c] += row['A' + c] + row['a' + c];
+                out.lowercase += row['a' + c];
+            }
+        }
+        out.total += s.size();
+    }
+
+#if RESIDUE_COUNTS_X86
+    // Each 32-byte vector is case-folded (| 0x20) and compared with every
+    // letter; the -1 lanes are subtracted into byte counters, which are
+    // widened with vpsadbw before they can wrap.
+    __attribute__((target("avx2"))) inline void count_avx2(std::string_view s, Counts &out)
+    {
+        constexpr std::size_t kUnroll = 4;                 // vectors per counter reload
+        constexpr std::size_t kFlushEvery = 255 / kUnroll; // rounds before a byte counter could wrap
+        const __m256i fold = _mm256_set1_epi8(0x20);
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i lower_bias = _mm256_set1_epi8(static_cast<char>(-128 - 'a')); // 'a'..'z' -> -128..-103
+        const __m256i lower_limit = _mm256_set1_epi8(-128 + 26);
+
+        __m256i acc[27];             // 26 letters + lowercase
+        __m256i wide[27];            // four 64-bit partial sums each
+        for (std::size_t k = 0; k < 27; ++k)
+            acc[k] = wide[k] = zero;
+
+        const char *p = s.data();
+        const std::size_t rounds = s.size() / (32 * kUnroll);
+        for (std::size_t r = 0; r < rounds; ++r, p += 32 * kUnroll)
+        {
+            __m256i v[kUnroll], f[kUnroll];
+#pragma GCC unroll 8
+            for (std::size_t u = 0; u < kUnroll; ++u)
+            {
+                v[u] = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + 32 * u));
+                f[u] = _mm256_or_si256(v[u], fold);
+            }
+#pragma GCC unroll 26
+            for (std::size_t k = 0; k < 26; ++k)
+            {
+                const __m256i letter = _mm256_set1_epi8(static_cast<char>('a' + k));
+                __m256i a = acc[k];
+#pragma GCC unroll 8
+                for (std::size_t u = 0; u < kUnroll; ++u)
+                    a = _mm256_sub_epi8(a, _mm256_cmpeq_epi8(f[u], letter));
+                acc[k] = a;
+            }
+            __m256i a = acc[26];
+#pragma GCC unroll 8
+            for (std::size_t u = 0; u < kUnroll; ++u)
+                a = _mm256_sub_epi8(a, _mm256_cmpgt_epi8(lower_limit, _mm256_add_epi8(v[u], lower_bias)));
+            acc[26] = a;
+
+            if ((r + 1) % kFlushEvery == 0 || r + 1 == rounds)
+            {
+                for (std::size_t k = 0; k < 27; ++k)
+                {
+                    wide[k] = _mm256_add_epi64(wide[k], _mm256_sad_epu8(acc[k], zero));
+                    acc[k] = zero;
+                }
+            }
+        }
+
+        alignas(32) std::uint64_t lanes[4];
+        for (std::size_t k = 0; k < 27; ++k)
+        {
+            _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), wide[k]);
+            const std::uint64_t n = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+            if (k < 26)
+                out.letter[k] += n;
+            else
+                out.lowercase += n;
+        }
+        out.total += static_cast<std::size_t>(p - s.data());
+        count_small(std::string_view(p, static_cast<std::size_t>(s.data() + s.size() - p)), out);
+    }
+#endif
+
+    using CountFn = void (*)(std::string_view, Counts &);
+
+    inline CountFn pick_count_fn()
+    {
+#if RESIDUE_COUNTS_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+            return count_avx2;
+#endif
+        return count_scalar;
+    }
+
+    // Chosen once per process; adds s to out.
+    inline const CountFn count = pick_count_fn();
+} // namespace residue_counts
@@ -0,0 +1,26 @@
+// scratch_arena.hpp — monotonic std::pmr arena with an inline first buffer for per-chunk scratch
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+
+// Bump allocation from an inline buffer, spilling to the heap in growing
+// blocks; deallocation is a no-op and reset() drops everything at once.
+// Lives on the stack of one worker job, so it is neither thread-safe nor
+// movable.
+template <std::size_t InlineBytes>
+class ScratchArena
+{
+public:
+    ScratchArena() = default;
+    ScratchArena(const ScratchArena &) = delete;
+    ScratchArena &operator=(const ScratchArena &) = delete;
+
+    std::pmr::memory_resource *resource() { return &resource_; }
+
+    // Invalidates everything allocated so far; the inline buffer is reused.
+    void reset() { resource_.release(); }
+
+private:
+    alignas(std::max_align_t) std::byte inline_[InlineBytes];
+    std::pmr::monotonic_buffer_resource resource_{inline_, InlineBytes, std::pmr::new_delete_resource()};
+};
@@ -0,0 +1,204 @@
+// simd_scan.hpp — vectorised '\n' / ':' / '[' block scanner, line splitter and substring test
+// SSE2 is the x86-64 baseline; AVX2 is picked at runtime when the CPU has it.
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SIMD_SCAN_X86 1
+#else
+#define SIMD_SCAN_X86 0
+#endif
+
+namespace simd_scan
+{
+    inline constexpr std::size_t kBlock = 64;
+
+    // Bit i is set when byte i of the 64-byte block is the character.
+    struct BlockMasks
+    {
+        std::uint64_t newline = 0;
+        std::uint64_t colon = 0;
+        std::uint64_t bracket = 0; // '['
+    };
+
+    inline BlockMasks scan_block_scalar(const char *p)
+    {
+        BlockMasks m;
+        for (std::size_t i = 0; i < kBlock; ++i)
+        {
+            const std::uint64_t bit = std::uint64_t{1} << i;
+            m.newline |= p[i] == '\n' ? bit : 0;
+            m.colon |= p[i] == ':' ? bit : 0;
+            m.bracket |= p[i] == '[' ? bit : 0;
+        }
+        return m;
+    }
+
+#if SIMD_SCAN_X86
+    inline BlockMasks scan_block_sse2(const char *p)
+    {
+        const __m128i nl = _mm_set1_epi8('\n');
+        const __m128i colon = _mm_set1_epi8(':');
+        const __m128i bracket = _mm_set1_epi8('[');
+        BlockMasks m;
+        for (std::size_t i = 0; i < kBlock; i += 16)
+        {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+            m.newline |= std::uint64_t(std::uint16_t(_mm_movemask_epi8(_mm_cmpeq_epi8(v, nl)))) << i;
+            m.colon |= std::uint64_t(std::uint16_t(_mm_movemask_epi8(_mm_cmpeq_epi8(v, colon)))) << i;
+            m.bracket |= std::uint64_t(std::uint16_t(_mm_movemask_epi8(_mm_cmpeq_epi8(v, bracket)))) << i;
+        }
+        return m;
+    }
+
+    __attribute__((target("avx2"))) inline std::uint64_t eq_mask_avx2(__m256i lo, __m256i hi, char c)
+    {
+        const __m256i needle = _mm256_set1_epi8(c);
+        const auto l = std::uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, needle)));
+        const auto h = std::uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, needle)));
+        return std::uint64_t(l) | (std::uint64_t(h) << 32);
+    }
+
+    __attribute__((target("avx2"))) inline BlockMasks scan_block_avx2(const char *p)
+    {
+        const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+        const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + 32));
+        return {eq_mask_avx2(lo, hi, '\n'), eq_mask_avx2(lo, hi, ':'), eq_mask_avx2(lo, hi, '[')};
+    }
+#endif
+
+    using BlockFn = BlockMasks (*)(const char *);
+
+    inline BlockFn pick_block_fn()
+    {
+#if SIMD_SCAN_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+            return scan_block_avx2;
+        return scan_block_sse2;
+#else
+        return scan_block_scalar;
+#endif
+    }
+
+    // Chosen once per process.
+    inline const BlockFn scan_block = pick_block_fn();
+
+    // Masks for the block at buf[off, off+64); bytes past the end read as 0.
+    inline BlockMasks scan_at(std::string_view buf, std::size_t off)
+    {
+        if (off + kBlock <= buf.size())
+            return scan_block(buf.data() + off);
+        char tail[kBlock] = {};
+        std::memcpy(tail, buf.data() + off, buf.size() - off);
+        return scan_block(tail);
+    }
+
+    // Splits a buffer into lines one 64-byte block at a time, reporting the
+    // first ':' of each line from the same masks.
+    class LineScanner
+    {
+    public:
+        explicit LineScanner(std::string_view buf) : buf_(buf) {}
+
+        // Next line without its '\n' (a trailing '\r' is kept); colon is the
+        // offset of the line's first ':' or npos. Returns false at the end.
+        bool next(std::string_view &line, std::size_t &colon)
+        {
+            if (pos_ >= buf_.size())
+                return false;
+            const std::size_t start = pos_;
+            colon = std::string_view::npos;
+
+            for (std::size_t block = start - start % kBlock; block < buf_.size(); block += kBlock)
+            {
+                if (block != block_)
+                {
+                    masks_ = scan_at(buf_, block);
+                    block_ = block;
+                }
+                const unsigned skip = block < start ? unsigned(start - block) : 0u;
+                const std::uint64_t live = ~std::uint64_t{0} << skip;
+                const std::uint64_t nl = masks_.newline & live;
+                std::uint64_t c = masks_.colon & live;
+                if (nl)
+                    c &= (nl & -nl) - 1; // only colons before the newline
+                if (colon == std::string_view::npos && c)
+                    colon = block + std::size_t(__builtin_ctzll(c)) - start;
+                if (nl)
+                {
+                    const std::size_t end = block + std::size_t(__builtin_ctzll(nl));
+                    line = buf_.substr(start, end - start);
+                    pos_ = end + 1;
+                    return true;
+                }
+            }
+            line = buf_.substr(start);
+            pos_ = buf_.size();
+            return true;
+        }
+
+        bool next(std::string_view &line)
+        {
+            std::size_t colon;
+            return next(line, colon);
+        }
+
+    private:
+        std::string_view buf_;
+        std::size_t pos_ = 0;
+        std::size_t block_ = std::size_t(-1);
+        BlockMasks masks_;
+    };
+
+    // Offset of the first '[' at or after `from` that begins a line (is
+    // preceded by '\n'), or npos. `from` must be at least 1.
+    inline std::size_t find_line_bracket(std::string_view buf, std::size_t from)
+    {
+        for (std::size_t block = from - from % kBlock; block < buf.size(); block += kBlock)
+        {
+            const auto m = scan_at(buf, block);
+            std::uint64_t prev_nl = block > 0 && buf[block - 1] == '\n' ? 1u : 0u;
+            std::uint64_t hits = ((m.newline << 1) | prev_nl) & m.bracket;
+            if (block < from)
+                hits &= ~std::uint64_t{0} << (from - block);
+            if (hits)
+                return block + std::size_t(__builtin_ctzll(hits));
+        }
+        return std::string_view::npos;
+    }
+
+    // True when needle occurs in hay. Tests 16 candidate positions at a time
+    // on the needle's first and last byte and memcmp's only the survivors.
+    inline bool contains(std::string_view hay, std::string_view needle)
+    {
+        const std::size_t n = needle.size();
+        if (n == 0)
+            return true;
+        if (n > hay.size())
+            return false;
+        if (n == 1)
+            return std::memchr(hay.data(), needle[0], hay.size()) != nullptr;
+#if SIMD_SCAN_X86
+        const __m128i first = _mm_set1_epi8(needle[0]);
+        const __m128i last = _mm_set1_epi8(needle[n - 1]);
+        std::size_t i = 0;
+        for (; i + n - 1 + 16 <= hay.size(); i += 16)
+        {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(hay.data() + i));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(hay.data() + i + n - 1));
+            auto mask = unsigned(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, last))));
+            for (; mask; mask &= mask - 1)
+                if (std::memcmp(hay.data() + i + __builtin_ctz(mask) + 1, needle.data() + 1, n - 2) == 0)
+                    return true;
+        }
+        return hay.substr(i).find(needle) != std::string_view::npos;
+#else
+        return hay.find(needle) != std::string_view::npos;
+#endif
+    }
+} // namespace simd_scan
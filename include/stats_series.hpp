@@ -0,0 +1,26 @@
+// stats_series.hpp — obsolete-stats per release, with per-release aggregates cached as <file>.gostats
+#pragma once
+#include <map>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "name_filter.hpp"
+#include "task3_utils.hpp"
+
+std::string stats_cache_path_for(const std::string &obo_path);
+
+// Unfiltered stats of one release, keyed like compute_obsolete_stats. Read
+// from <file>.gostats while that matches the file (same key as .gocache);
+// otherwise scanned, and written back when use_cache is set.
+std::map<std::string, NamespaceStats> release_obsolete_stats(const std::string &obo_path, unsigned threads, bool use_cache);
+
+// compute_obsolete_stats for each release on its own, in input order. A
+// namespace filter is applied to the cached per-namespace aggregates, so
+// only new or changed releases are parsed; a name filter needs the terms
+// themselves, so every release is scanned then.
+std::vector<std::map<std::string, NamespaceStats>> obsolete_stats_series(
+    const std::vector<std::string> &releases,
+    const std::unordered_set<std::string> &ns_filter, // empty => all
+    const NameFilter *name_filter,                    // nullptr => no filter
+    unsigned threads = 1,                             // 0 => all cores
+    bool use_cache = false);                          // read/write .gostats (and .gocache)
@@ -0,0 +1,66 @@
+// tab_writer.hpp — buffered TSV writer: cells formatted in place, flushed a megabyte at a time
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include "go_id.hpp"
+
+// Cells are appended straight into one reusable buffer (numbers via
+// std::to_chars, GO IDs via GoId::format) with tabs between them. The
+// buffer goes out in a single write() once it holds kBufferBytes, and a
+// cell too large to buffer is written together with the buffer by one
+// writev(). The sink is a file descriptor or, with a smaller buffer, a
+// std::string (server replies). The first failed write is reported on
+// stderr with the sink's name and strerror; later writes are dropped.
+class TabWriter
+{
+public:
+    static constexpr std::size_t kBufferBytes = std::size_t{1} << 20;
+    static constexpr std::size_t kStringBufferBytes = std::size_t{16} << 10;
+
+    explicit TabWriter(int fd, bool owns_fd = false, std::string name = "standard output"); // name: for error messages
+    explicit TabWriter(std::string &out);
+    ~TabWriter(); // flushes and closes an owned fd
+
+    TabWriter(const TabWriter &) = delete;
+    TabWriter &operator=(const TabWriter &) = delete;
+
+    TabWriter &cell(std::string_view s);
+    TabWriter &cell(std::uint64_t n);
+    TabWriter &cell(GoId id);
+    TabWriter &cell(std::span<const GoId> ids); // comma-separated, one cell
+
+    void end_row();
+    void row(std::span<const std::string_view> cells);
+
+    // Writes out everything buffered; false once any write has failed.
+    bool flush();
+    bool ok() const { return ok_; }
+
+private:
+    char *reserve(std::size_t n); // room for n bytes, flushing first if needed
+    void separate();
+    void write_out(std::string_view extra); // buffer, then extra
+
+    std::size_t capacity_;
+    std::unique_ptr<char[]> buf_;
+    std::size_t used_ = 0;
+    bool row_open_ = false;
+    int fd_ = -1;
+    bool owns_fd_ = false;
+    std::string name_;
+    std::string *str_ = nullptr;
+    bool ok_ = true;
+};
+
+// Opens (truncating) the --output file for a TabWriter; -1 after printing
+// the error when the path does not end in .tab or cannot be created.
+int open_tab_file(const std::string &path);
+
+// A writer on the --output file when one is given, else on stdout;
+// nullopt when open_tab_file failed.
+std::optional<TabWriter> open_tab_output(const std::optional<std::string> &path);
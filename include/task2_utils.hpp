@@ -1,21 +1,28 @@
 // task2_utils.hpp — OBO parsing + consider-table (Task 2)
 #pragma once
-#include <regex>
 #include <string>
 #include <unordered_set>
 #include <vector>
+#include "go_id.hpp"
+#include "name_filter.hpp"
+#include "tab_writer.hpp"
 
 // A single result row:
-// obsolete_id, comma-separated alternative_ids, parent_id (is_a/part_of parent if present)
+// obsolete_id, alternative_ids (consider, then replaced_by), parent_id (is_a/part_of parent if present)
 struct ConsiderRow
 {
-    std::string obsolete_id;
-    std::string alternatives_csv; // "GO:xxxx,GO:yyyy"
-    std::string parent_id;        // from is_a/part_of; empty if none
+    GoId obsolete_id;
+    std::vector<GoId> alternatives;
+    GoId parent_id; // from is_a/part_of; invalid if none
 };
 
+// GO:obsolete_id <tab> GO:alt,GO:alt <tab> GO:parent <newline>
+void write_consider_row(TabWriter &out, const ConsiderRow &row);
+
 std::vector<ConsiderRow> build_consider_table(
     const std::vector<std::string> &obo_files,
     const std::unordered_set<std::string> &ns_filter, // empty => all
-    const std::regex *name_filter                     // nullptr => no filter
+    const NameFilter *name_filter,                    // nullptr => no filter
+    unsigned threads = 1,                             // parallel chunk workers; 0 => all cores
+    bool use_cache = false                            // read/write <file>.gocache snapshots
 );
@@ -1,23 +1,45 @@
 // task3_utils.hpp — stats + optional tab output (Task 3)
 #pragma once
 #include <map>
-#include <regex>
 #include <string>
+#include <string_view>
 #include <unordered_set>
 #include <vector>
+#include "name_filter.hpp"
+#include "tab_writer.hpp"
 
-// Stats per namespace (or "all"): obsolete_count, with_alternatives_count
+// Stats per namespace plus an "all" total: obsolete_count, with_alternatives_count
+// (an alternative is any consider or replaced_by target), and the same terms
+// split by what they offer: any replaced_by, consider only, or nothing.
 struct NamespaceStats
 {
     std::size_t obsolete_total = 0;
-    std::size_t with_alternatives = 0;
+    std::size_t with_alternatives = 0; // with_replaced_by + consider_only
+    std::size_t with_replaced_by = 0;
+    std::size_t consider_only = 0;
+    std::size_t no_alternative = 0;
+
+    NamespaceStats &operator+=(const NamespaceStats &o)
+    {
+        obsolete_total += o.obsolete_total;
+        with_alternatives += o.with_alternatives;
+        with_replaced_by += o.with_replaced_by;
+        consider_only += o.consider_only;
+        no_alternative += o.no_alternative;
+        return *this;
+    }
 };
 
 std::map<std::string, NamespaceStats> compute_obsolete_stats(
     const std::vector<std::string> &obo_files,
-    const std::unordered_set<std::string> &ns_filter,
-    const std::regex *name_filter);
+    const std::unordered_set<std::string> &ns_filter, // empty => all
+    const NameFilter *name_filter,                    // nullptr => no filter
+    unsigned threads = 1,                             // parallel chunk workers; 0 => all cores
+    bool use_cache = false);                          // read/write <file>.gocache snapshots
+
+// Header row for write_stats_rows; with_release adds a leading "release" column.
+void write_stats_header(TabWriter &out, bool with_release = false);
 
-// Writes out rows to .tab (validates .tab extension elsewhere)
-bool write_tab_file(const std::string &path,
-                    const std::vector<std::vector<std::string>> &rows);
+// One row per namespace, prefixed by release when it is non-empty.
+void write_stats_rows(TabWriter &out, const std::map<std::string, NamespaceStats> &stats,
+                      std::string_view release = {});
@@ -1,34 +1,45 @@
 // task_utils.hpp — shared utilities for GO parser tasks
 #pragma once
 #include <argparse/argparse.hpp>
-#include <regex>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_set>
 #include <optional>
+#include "name_filter.hpp"
 
 struct CLIOptions
 {
-    // Common across tasks
+    // Common across tasks; --combined sets both modes
     bool consider_table = false;
     bool obsolete_stats = false;
+    bool diff_releases = false;                 // task2: changes between consecutive inputs
+    bool resolve_replacements = false;          // task2: final live targets of obsolete terms
+    bool time_series = false;                   // task3: obsolete-stats per input, in input order
+    std::optional<std::string> serve_socket;    // task3 --serve SOCKET: answer queries until stopped
     std::vector<std::string> obo_files;         // required ≥1
     std::unordered_set<std::string> namespaces; // optional filter
-    std::optional<std::regex> name_pattern;     // optional name filter
-    std::optional<std::string> output_tab;      // task3 optional
+    std::optional<NameFilter> name_pattern;     // optional name filter
+    std::optional<std::string> output_tab;      // --output FILE.tab, else stdout
+    unsigned threads = 0;                       // --threads N; 0 => all cores
+    bool use_cache = true;                      // --no-cache clears
+    std::vector<std::string> cached_files;      // inputs whose .gocache matches by size and mtime
 };
 
 // ---- Namespaces helpers ----
 bool is_valid_namespace(const std::string &ns);
 void normalize_and_validate_namespaces(const std::vector<std::string> &raw,
                                        std::unordered_set<std::string> &out);
+std::vector<std::string> split_csv(std::string_view csv); // empty fields dropped
+bool namespace_allowed(const std::unordered_set<std::string> &filter, std::string_view ns); // empty filter => all
 
 // ---- Files / extensions ----
-bool has_obo_ext_ci(const std::string &path); // .obo (case-insensitive)
+bool has_obo_ext_ci(const std::string &path); // .obo, .obo.gz, .obo.xz, .obo.zst (case-insensitive)
 void validate_input_files(const std::vector<std::string> &files,
                           std::vector<std::string> &valid,
                           std::vector<std::string> &invalid_ext,
-                          std::vector<std::string> &missing);
+                          std::vector<std::string> &missing,
+                          std::vector<std::string> *fresh_cache = nullptr); // valid files passing cache_is_fresh
 
 // ---- Usage & CLI parsing ----
 void print_usage(const std::string &progname);
@@ -0,0 +1,147 @@
+// term_table.hpp — columnar GO term table and its binary snapshot cache (<file>.obo.gocache)
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "go_id.hpp"
+#include "obo_scanner.hpp"
+
+// Compressed sparse rows: the targets of term i are targets[offsets[i] .. offsets[i+1]).
+struct CsrView
+{
+    const std::uint32_t *offsets = nullptr;
+    const GoId *targets = nullptr;
+
+    std::span<const GoId> row(std::size_t i) const
+    {
+        return {targets + offsets[i], targets + offsets[i + 1]};
+    }
+};
+
+// Read-only columns of a term table, backed either by a TermTableBuilder or
+// by a mapped cache file. Namespaces are stored as one byte per term that
+// indexes a small per-table dictionary.
+class TermTableView
+{
+public:
+    std::size_t size() const { return count_; }
+
+    GoId id(std::size_t i) const { return ids_[i]; }
+    std::string_view name(std::size_t i) const
+    {
+        return {name_blob_ + name_offsets_[i], name_offsets_[i + 1] - name_offsets_[i]};
+    }
+    std::string_view ns(std::size_t i) const
+    {
+        const auto k = ns_[i];
+        return {ns_blob_ + ns_offsets_[k], ns_offsets_[k + 1] - ns_offsets_[k]};
+    }
+    bool is_obsolete(std::size_t i) const { return (obsolete_[i / 64] >> (i % 64)) & 1u; }
+
+    CsrView consider, replaced_by, alt_id, is_a, part_of;
+
+    // Fills the reusable stanza record, so table rows go through the same
+    // visitors as freshly scanned stanzas.
+    void load(std::size_t i, OboTerm &out) const;
+
+private:
+    friend class TermTableBuilder;
+    friend class TermCache;
+
+    std::size_t count_ = 0;
+    const GoId *ids_ = nullptr;
+    const std::uint32_t *name_offsets_ = nullptr;
+    const char *name_blob_ = nullptr;
+    const std::uint8_t *ns_ = nullptr;
+    const std::uint32_t *ns_offsets_ = nullptr;
+    const char *ns_blob_ = nullptr;
+    const std::uint64_t *obsolete_ = nullptr;
+};
+
+// Identifies the source an .gocache snapshot was built from.
+struct CacheKey
+{
+    std::uint64_t source_size = 0;
+    std::int64_t source_mtime_ns = 0;
+    std::uint64_t content_hash = 0;
+    std::uint64_t path_hash = 0;
+};
+
+// Growable columns, filled stanza by stanza (or chunk by chunk via append).
+class TermTableBuilder
+{
+public:
+    TermTableBuilder();
+
+    // Scanner fields the builder stores; pass to for_each_term.
+    static constexpr unsigned kFields = obo_field::kAll & ~obo_field::kXref;
+
+    void add(const OboTerm &t);
+    void append(const TermTableBuilder &other); // other's terms after ours
+    std::size_t size() const { return ids_.size(); }
+
+    TermTableView view() const; // invalidated by add/append
+
+    // Writes the snapshot atomically (replace_file); false on I/O failure.
+    bool write_cache(const std::string &cache_path, const CacheKey &key) const;
+
+private:
+    struct Csr
+    {
+        std::vector<std::uint32_t> offsets{0};
+        std::vector<GoId> targets;
+
+        void add(std::span<const GoId> row);
+        void append(const Csr &other);
+    };
+
+    std::uint8_t ns_code(std::string_view ns);
+
+    std::vector<GoId> ids_;
+    std::vector<std::uint32_t> name_offsets_{0};
+    std::string name_blob_;
+    std::vector<std::uint8_t> ns_;
+    std::vector<std::uint32_t> ns_offsets_{0};
+    std::string ns_blob_;
+    std::vector<std::uint64_t> obsolete_;
+    Csr consider_, replaced_by_, alt_id_, is_a_, part_of_;
+};
+
+// A mapped snapshot. open() succeeds only when the cache exists, is
+// well-formed (column sizes, offsets and namespace codes all checked) and
+// still matches its source file; otherwise the caller rebuilds it.
+class TermCache
+{
+public:
+    bool open(const std::string &obo_path);
+    const TermTableView &view() const { return view_; }
+
+private:
+    MappedFile file_{};
+    TermTableView view_;
+};
+
+std::string cache_path_for(const std::string &obo_path);
+
+// Key for obo_path; contents must be the file's current bytes.
+CacheKey make_cache_key(const std::string &obo_path, std::string_view contents);
+
+// make_cache_key in two steps, for callers that hash the bytes they parse:
+// stat the source before reading it, then hash what was read. A file
+// rewritten in between then fails its key next time instead of passing it.
+CacheKey stat_cache_key(const std::string &obo_path); // content_hash left 0
+std::uint64_t hash_cache_contents(std::string_view contents);
+
+// True when key still describes obo_path: size and mtime match, or the
+// content hash still does. Shared by every per-file sidecar cache.
+bool cache_key_matches(const std::string &obo_path, const CacheKey &key);
+
+// Cheap check for the "(cached)" listing: the snapshot header is readable
+// and size, mtime and path still match. Never hashes the source, so a
+// touched-but-identical file reads as stale here even though
+// TermCache::open still accepts it; freshness that matters is decided
+// there, once per input.
+bool cache_is_fresh(const std::string &obo_path);
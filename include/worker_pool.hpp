@@ -0,0 +1,67 @@
+// worker_pool.hpp — minimal fork/join pool for index-addressed jobs
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 0 => one worker per hardware thread
+inline unsigned resolve_thread_count(unsigned requested)
+{
+    if (requested > 0)
+        return requested;
+    const unsigned hw = std::thread::hardware_concurrency();
+    return hw > 0 ? hw : 1;
+}
+
+// Runs job(i) exactly once for every i in [0, n) on up to `threads` workers.
+// Jobs are handed out in index order; callers write into slot i of a
+// pre-sized vector and merge afterwards, which keeps output deterministic.
+// The first exception thrown by any job is rethrown once all workers joined.
+template <typename Job>
+void parallel_for_index(std::size_t n, unsigned threads, Job &&job)
+{
+    const std::size_t workers = std::min<std::size_t>(resolve_thread_count(threads), n);
+    if (workers <= 1)
+    {
+        for (std::size_t i = 0; i < n; ++i)
+            job(i);
+        return;
+    }
+
+    std::atomic<std::size_t> next{0};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    auto run = [&]()
+    {
+        for (std::size_t i = next.fetch_add(1); i < n; i = next.fetch_add(1))
+        {
+            try
+            {
+                job(i);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error)
+                    error = std::current_exception();
+                next.store(n); // stop handing out work
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (std::size_t w = 1; w < workers; ++w)
+        pool.emplace_back(run);
+    run(); // the calling thread is worker 0
+    for (auto &t : pool)
+        t.join();
+
+    if (error)
+        std::rethrow_exception(error);
+}
@@ -11,104 +11,836 @@
 #include <unordered_set>         // Hash set for deduplication
 #include <algorithm>             // String transformations
 #include <sstream>               // String stream operations
+#include <string_view>           // Non-owning record views
+#include <memory>                // Owned inflate stream
+#include <optional>              // Optional BGZF handle / fetch result
+#include <unordered_map>         // Index lookup by ID
+#include <charconv>              // .fai number parsing
+#include <cstring>               // memchr
+#include <cerrno>                // EINTR
+#include <fcntl.h>               // open
+#include <unistd.h>              // pread
+#include <array>                 // Byte class table
+#include <cstdio>                // Spill files for multi-pattern output
+#include <functional>            // std::greater
+#include "bgzf.hpp"              // BGZF block random access (../../../include)
+#include "residue_counts.hpp"    // AVX2 residue histogram (../../../include)
+#include "low_complexity.hpp"    // DUST / SEG windows for --composition (../../../include)
+#include "packed_seq.hpp"        // 2-bit / 5-bit in-memory sequences (../../../include)
+#include "decompress.hpp"        // Streaming gzip/xz inflate (../../../include)
+#include "simd_scan.hpp"         // Shared SIMD line splitter (../../../include)
 
 namespace fs = std::filesystem; // Alias for filesystem namespace
 
 // Structure to store search result information
 struct SearchHit
-{                        // Search result data
-    std::string id;      // Sequence ID
-    std::string pattern; // Search pattern
-    bool match;          // Match result
+{                             // Search result data
+    std::string_view id;      // Sequence ID (valid during the callback)
+    std::string_view pattern; // Search pattern
+    bool match;               // Match result
+    std::size_t position;     // 0-based start of the first match; npos if none
 };
 
 // Structure to store sequence length information
 struct LengthInfo
-{                       // Sequence length data
-    std::string id;     // Sequence ID
-    std::size_t length; // Sequence length
+{                         // Sequence length data
+    std::string_view id;  // Sequence ID (valid during the callback)
+    std::size_t length;   // Sequence length
 };
 
-// Class for parsing and processing FASTA files
-class FastaParser
-{ // FASTA file processor
+// One record held packed in memory for repeated searches
+struct PackedRecord
+{                   // ID plus packed sequence
+    std::string id; // Header up to the first space/tab
+    PackedSeq seq;  // 2-bit or 5-bit codes
+};
+
+// One FASTA record; the views point into the reader's buffer and stay
+// valid until the next call to FastaReader::next
+struct FastaRecord
+{                            // Record views
+    std::string_view id;     // Header up to the first space/tab
+    std::string_view header; // Whole header line without '>'
+    std::string_view seq;    // Sequence with line breaks and whitespace removed
+};
+
+// std::isspace in the C locale, without the locale lookup
+static constexpr bool is_space(unsigned char c)
+{ // c: input byte
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+// Pull-based FASTA reader: the input is read (or inflated) a chunk at a
+// time and only the current record is held, with its sequence lines
+// compacted in place, so memory is bounded by the largest record rather
+// than the file
+class FastaReader
+{ // Streaming record reader
 public:
-    // Parse FASTA file into ID-sequence pairs
-    static std::vector<std::pair<std::string, std::string>>
-    parseFile(const std::string &filename)
-    {                               // filename: input file path
-        std::ifstream in(filename); // Open input file
-        if (!in)
+    static constexpr std::size_t kChunkBytes = InflateStream::kBlockBytes; // Bytes per plain read
+
+    explicit FastaReader(const std::string &filename)
+    {                                                  // filename: input file path
+        if (detect_codec_of(filename) != Codec::kNone)
+        {                                              // gzip (incl. BGZF) / xz / zstd
+            inflate_ = std::make_unique<InflateStream>(filename); // Inflate on a producer thread
+            return;
+        }
+        in_.open(filename, std::ios::binary); // Open input file
+        if (!in_)
         {                                                              // Check file opening
             throw std::runtime_error("Cannot open file: " + filename); // Throw error
         }
-        std::vector<std::pair<std::string, std::string>> records; // Store records
-        std::string line, id, seq;                                // Current line, ID, sequence
+    }
 
-        auto flush = [&]() { // Flush current record
-            if (!id.empty())
-            {                                  // Check if ID exists
-                records.emplace_back(id, seq); // Add record
+    // Next record with a non-empty ID; false at the end of the input
+    bool next(FastaRecord &rec)
+    {                                    // rec: filled with views into buf_
+        for (;;)
+        {
+            std::size_t head;            // '>' of the next header
+            while ((head = find_header(pos_)) == std::string::npos)
+            {                            // No header buffered yet
+                if (!refill())
+                    return false;        // End of input
             }
-            id.clear();  // Clear ID
-            seq.clear(); // Clear sequence
-        };
+            pos_ = head;                 // refill keeps the record from here
 
-        while (std::getline(in, line))
-        { // Read lines
-            if (line.empty())
-                continue; // Skip empty lines
-            if (line[0] == '>')
-            {                                                               // Check header line
-                flush();                                                    // Flush previous record
-                std::string rest = line.substr(1);                          // Extract header content
-                size_t sp = rest.find_first_of(" \t");                      // Find space/tab
-                id = (sp == std::string::npos) ? rest : rest.substr(0, sp); // Extract ID
+            std::string_view line;       // Header line, completed across chunks
+            for (;;)
+            {
+                simd_scan::LineScanner lines(std::string_view(buf_).substr(pos_));
+                lines.next(line);
+                if (pos_ + line.size() < buf_.size() || !refill())
+                    break;               // '\n' buffered, or the last line of the input
+            }
+            const std::size_t header_bytes = line.size();
+
+            std::size_t from = std::min(header_bytes + 1, buf_.size() - pos_); // Relative: refill moves pos_ to 0
+            std::size_t end;             // '>' of the following header, or the end of the input
+            for (;;)
+            {
+                std::size_t at = pos_ + from;
+                if ((end = find_header(at)) != std::string::npos)
+                    break;
+                from = at - pos_;
+                if (!refill())
+                {                        // Last record ends the input
+                    end = buf_.size();
+                    break;
+                }
+            }
+            const std::size_t body = std::min(pos_ + header_bytes + 1, end);
+            std::string_view header(buf_.data() + pos_ + 1, header_bytes - 1);
+            pos_ = end;                  // Next search starts at the following header
+
+            if (!header.empty() && header.back() == '\r')
+                header.remove_suffix(1); // CRLF input
+            const std::size_t sp = header.find_first_of(" \t\r"); // ID ends at space/tab
+            rec.id = header.substr(0, sp);
+            if (rec.id.empty())
+                continue;                // Records without an ID are dropped
+            rec.header = header;
+
+            // Drop every whitespace byte (line breaks included) in place;
+            // the write cursor never passes the read cursor
+            char *const first = buf_.data() + body;
+            const char *const last = buf_.data() + end;
+            char *w = first;
+            for (const char *r = first; r != last; ++r)
+            {                            // Branch-free filter
+                *w = *r;
+                w += !is_space(static_cast<unsigned char>(*r));
+            }
+            rec.seq = std::string_view(first, static_cast<std::size_t>(w - first));
+            return true;
+        }
+    }
+
+private:
+    // Drops the bytes before pos_ and appends the next chunk; false at the end
+    bool refill()
+    {
+        if (eof_)
+            return false;
+        buf_.erase(0, pos_); // Keep only the unfinished record
+        pos_ = 0;
+        if (inflate_)
+        {                                        // Next inflated block
+            const auto block = inflate_->next();
+            eof_ = block.empty();
+            buf_.append(block);
+            return !eof_;
+        }
+        const std::size_t old = buf_.size();
+        buf_.resize_and_overwrite(old + kChunkBytes, [&](char *p, std::size_t)
+                                  {                  // Read straight into the buffer
+                                      in_.read(p + old, static_cast<std::streamsize>(kChunkBytes));
+                                      return old + static_cast<std::size_t>(in_.gcount()); });
+        eof_ = buf_.size() == old;
+        return !eof_;
+    }
+
+    // Start of the first line at or after `from` (a line start) that begins
+    // with '>', split with the shared SIMD LineScanner. npos when no buffered
+    // line does; `from` then moves to where the search resumes after a
+    // refill (the start of an unfinished last line, else the buffer end).
+    std::size_t find_header(std::size_t &from) const
+    {                                        // from: line start in buf_
+        simd_scan::LineScanner lines(std::string_view(buf_).substr(from));
+        std::string_view line;
+        while (lines.next(line))
+        {
+            const auto at = static_cast<std::size_t>(line.data() - buf_.data());
+            if (!line.empty() && line[0] == '>')
+                return at;
+            from = at + line.size() < buf_.size() ? at + line.size() + 1 : at;
+        }
+        return std::string::npos;
+    }
+
+    std::ifstream in_;                       // Plain input
+    std::unique_ptr<InflateStream> inflate_; // Compressed input
+    std::string buf_;                        // Unconsumed input, starting at a line
+    std::size_t pos_ = 0;                    // Start of the unconsumed bytes
+    bool eof_ = false;                       // Input exhausted
+};
+
+// One .fai line (samtools faidx layout): offsets are into the uncompressed
+// text, so a BGZF file shares the layout of its plain twin
+struct FaiEntry
+{                             // Index record
+    std::string name;         // Record ID
+    std::uint64_t length = 0; // Sequence length in bases
+    std::uint64_t offset = 0; // Byte offset of the first base
+    std::uint64_t line_bases = 0; // Bases per full line; 0 => empty record, or irregular lines (never saved)
+    std::uint64_t line_width = 0; // Bytes per full line, line break included
+};
+
+// <file>.fai next to the FASTA, rebuilt in one pass when missing or older
+// than the file. Lengths come straight from the index; sequences are read
+// with pread (plain) or BgzfFile::read (BGZF) at computed offsets. Records
+// whose lines differ in width have no samtools layout: like samtools, the
+// file then gets no .fai, and the index is kept in memory for lengths. In
+// a BGZF file such a record is read from its first base up to the next
+// header (BgzfFile::read_record); in a plain file it is streamed.
+// Non-BGZF compressed files are also fetched by streaming.
+class FastaIndex
+{ // faidx-style index + random access
+public:
+    explicit FastaIndex(const std::string &filename)
+    {                                                     // filename: FASTA path
+        const Codec codec = detect_codec_of(filename);    // Sniff magic bytes
+        if (codec == Codec::kNone)
+        {                                                 // Plain text: pread
+            fd_ = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd_ < 0)
+            {
+                throw std::runtime_error("Cannot open file: " + filename); // Throw error
             }
+        }
+        else if (codec == Codec::kGzip && is_bgzf(MappedFile(filename).view()))
+        {                                                 // BGZF: block random access
+            bgzf_.emplace(filename, true);                // Keeps a .gzi next to the .fai
+        }
+        const std::string fai = filename + ".fai";        // Index path
+        std::error_code ec;
+        const bool fresh = fs::exists(fai, ec) &&
+                           fs::last_write_time(fai, ec) >= fs::last_write_time(filename, ec) && !ec;
+        if (!fresh || !load(fai))
+        {                                                 // Missing, stale or unreadable
+            entries_.clear();
+            build(filename, codec);
+            if (std::all_of(entries_.begin(), entries_.end(), [](const FaiEntry &e)
+                            { return e.line_bases != 0 || e.length == 0; }))
+                save(fai);
             else
-            { // Sequence line
-                for (char c : line)
-                { // Process characters
-                    if (!std::isspace(static_cast<unsigned char>(c)))
-                    {                     // Skip whitespace
-                        seq.push_back(c); // Append to sequence
-                    }
+                std::cerr << "Warning: " << filename << " has records with uneven line lengths; "
+                          << "no .fai written, they are read " << (bgzf_ ? "up to the next header\n" : "by streaming\n");
+        }
+        by_name_.reserve(entries_.size());
+        for (std::size_t i = 0; i < entries_.size(); ++i)
+        {                                                 // First record wins on duplicates
+            by_name_.emplace(entries_[i].name, i);
+        }
+    }
+
+    ~FastaIndex()
+    {
+        if (fd_ >= 0)
+            ::close(fd_);
+    }
+
+    FastaIndex(const FastaIndex &) = delete;
+    FastaIndex &operator=(const FastaIndex &) = delete;
+
+    const std::vector<FaiEntry> &entries() const { return entries_; } // File order
+
+    const FaiEntry *find(std::string_view name) const
+    {                                                                  // name: record ID
+        const auto it = by_name_.find(name);
+        return it == by_name_.end() ? nullptr : &entries_[it->second];
+    }
+
+    // Bases [begin, end) of a record (0-based); nullopt when the record
+    // cannot be reached by offset and has to be streamed
+    std::optional<std::string> fetch(const FaiEntry &e, std::uint64_t begin, std::uint64_t end) const
+    {                                                        // e: index entry
+        if (begin >= end)
+            return std::string{};
+        if (e.line_bases == 0 && bgzf_)
+        {                                                    // Uneven lines: inflate up to the next header
+            std::string raw = bgzf_->read_record(e.offset, '>');
+            std::erase_if(raw, [](char c)
+                          { return is_space(static_cast<unsigned char>(c)); });
+            if (raw.size() != e.length)
+            {                                                // File changed under the index
+                throw std::runtime_error("Index out of date for record: " + e.name);
+            }
+            return raw.substr(static_cast<std::size_t>(begin), static_cast<std::size_t>(end - begin));
+        }
+        if (e.line_bases == 0 || (fd_ < 0 && !bgzf_))
+            return std::nullopt;
+        const auto at = [&](std::uint64_t i)
+        { return e.offset + i / e.line_bases * e.line_width + i % e.line_bases; }; // Byte of base i
+        const std::uint64_t first = at(begin);
+        const std::size_t span = static_cast<std::size_t>(at(end - 1) + 1 - first);
+        std::string raw;
+        if (bgzf_)
+        {                                                    // Inflate only the covering blocks
+            raw = bgzf_->read(first, span);
+        }
+        else
+        {                                                    // One positioned read
+            raw.resize_and_overwrite(span, [&](char *p, std::size_t)
+                                     {                       // Sized by span: the callback may see the capacity
+                                         std::size_t got = 0;
+                                         while (got < span)
+                                         {
+                                             const ssize_t r = ::pread(fd_, p + got, span - got, static_cast<off_t>(first + got));
+                                             if (r < 0 && errno == EINTR)
+                                                 continue;
+                                             if (r <= 0)
+                                                 break;
+                                             got += static_cast<std::size_t>(r);
+                                         }
+                                         return got; });
+        }
+        std::erase_if(raw, [](char c)
+                      { return c == '\n' || c == '\r'; }); // Drop line breaks
+        if (raw.size() != end - begin)
+        {                                                     // File changed under the index
+            throw std::runtime_error("Index out of date for record: " + e.name);
+        }
+        return raw;
+    }
+
+private:
+    // Reads <file>.fai; false on any malformed line
+    bool load(const std::string &fai)
+    {                                     // fai: index path
+        std::ifstream in(fai);
+        if (!in)
+            return false;
+        std::string line;
+        while (std::getline(in, line))
+        {                                 // name, length, offset, line_bases, line_width
+            const auto tab = line.find('\t');
+            if (tab == std::string::npos || tab == 0)
+                return false;
+            FaiEntry e;
+            e.name = line.substr(0, tab);
+            const char *p = line.data() + tab;
+            const char *const last = line.data() + line.size();
+            for (std::uint64_t *field : {&e.length, &e.offset, &e.line_bases, &e.line_width})
+            {                             // Four tab-prefixed numbers
+                if (p == last || *p != '\t')
+                    return false;
+                const auto [next, err] = std::from_chars(p + 1, last, *field);
+                if (err != std::errc{})
+                    return false;
+                p = next;
+            }
+            if (e.line_bases == 0 && e.length > 0)
+                return false;             // Not samtools layout (older build): rebuild
+            entries_.push_back(std::move(e));
+        }
+        return true;
+    }
+
+    // Writes the index through a unique temporary file (replace_file); an
+    // unwritable directory only costs the rebuild next time
+    void save(const std::string &fai) const
+    {                                     // fai: index path
+        std::ostringstream out;
+        for (const auto &e : entries_)
+        {                                 // samtools column order
+            out << e.name << '\t' << e.length << '\t' << e.offset << '\t'
+                << e.line_bases << '\t' << e.line_width << '\n';
+        }
+        const std::string text = out.str();
+        const std::string_view bytes = text;
+        replace_file(fai, {&bytes, 1});
+    }
+
+    // One pass over the (inflated) text, a line at a time
+    void build(const std::string &filename, Codec codec)
+    {                                     // filename: FASTA path
+        std::uint64_t pos = 0;            // Offset of the next line
+        bool skip = true;                 // Outside a record (or in one without an ID)
+        bool regular = false;             // Current record is reachable by offset
+        bool ended = false;               // Current record saw its short/blank last line
+        auto line = [&](std::string_view text)
+        {                                 // text: one line, '\n' included unless at EOF
+            pos += text.size();
+            std::size_t eol = 0;
+            if (!text.empty() && text.back() == '\n')
+                text.remove_suffix(1), ++eol;
+            if (!text.empty() && text.back() == '\r')
+                text.remove_suffix(1), ++eol;
+            if (!text.empty() && text.front() == '>')
+            {                             // Header: same ID rule as FastaReader
+                const auto header = text.substr(1);
+                const auto id = header.substr(0, header.find_first_of(" \t\r"));
+                skip = id.empty();
+                regular = true;
+                ended = false;
+                if (!skip)
+                    entries_.push_back({std::string(id), 0, pos, 0, 0});
+                return;
+            }
+            if (skip)
+                return;
+            auto &e = entries_.back();
+            std::size_t bases = 0;
+            for (const char c : text)
+            {                             // Whitespace is not sequence
+                bases += !is_space(static_cast<unsigned char>(c));
+            }
+            e.length += bases;
+            if (!regular)
+                return;
+            if (text.empty())
+            {                             // Blank lines may only trail
+                ended = true;
+                return;
+            }
+            const bool fits = bases == text.size() && !ended &&                 // No inner whitespace, nothing after the last line
+                              (e.line_bases == 0 || bases < e.line_bases ||     // First or short line
+                               (bases == e.line_bases && (!eol || bases + eol == e.line_width))); // Full line, same break
+            if (!fits)
+            {                             // Lengths only from here on
+                regular = false;
+                e.line_bases = e.line_width = 0;
+                return;
+            }
+            if (e.line_bases == 0)
+            {                             // First line sets the width
+                e.line_bases = bases;
+                e.line_width = bases + eol;
+            }
+            else if (bases < e.line_bases)
+            {                             // Short line: must be the last
+                ended = true;
+            }
+        };
+
+        if (codec == Codec::kNone)
+        {                                 // Whole mapped file, zero-copy
+            const MappedFile map(filename);
+            for_each_line(map.view(), line);
+            return;
+        }
+        InflateStream in(filename);       // Inflate on a producer thread
+        std::string carry;                // Line split across blocks
+        for (auto block = in.next(); !block.empty(); block = in.next())
+        {
+            const auto cut = block.rfind('\n');
+            if (cut == std::string_view::npos)
+            {                             // No line ends in this block
+                carry.append(block);
+                continue;
+            }
+            carry.append(block.substr(0, cut + 1));
+            for_each_line(carry, line);
+            carry.assign(block.substr(cut + 1));
+        }
+        for_each_line(carry, line);
+    }
+
+    // Calls visit with each line, '\n' included; the last may lack one
+    template <typename Visit>
+    static void for_each_line(std::string_view text, Visit &visit)
+    {                                     // text: whole lines
+        simd_scan::LineScanner lines(text); // Shared SIMD line splitter
+        std::string_view line;
+        while (lines.next(line))
+        {                                 // Put the '\n' back when there is one
+            const bool nl = line.data() + line.size() < text.data() + text.size();
+            visit(std::string_view(line.data(), line.size() + nl));
+        }
+    }
+
+    std::vector<FaiEntry> entries_;                             // File order
+    std::unordered_map<std::string_view, std::size_t> by_name_; // ID -> entries_ index
+    int fd_ = -1;                                               // Plain input
+    std::optional<BgzfFile> bgzf_;                              // BGZF input
+};
+
+// Aho-Corasick automaton over literal patterns. The goto function is
+// completed into a dense DFA over the bytes the patterns use (every other
+// byte is one shared class that leads back to the root), so the scan is one
+// table lookup per sequence byte whatever the number of patterns.
+class LiteralMatcher
+{ // Multi-literal scanner
+public:
+    explicit LiteralMatcher(const std::vector<std::string_view> &literals)
+    {                                                      // literals: distinct, non-empty
+        for (const auto lit : literals)
+        {                                                  // Assign byte classes
+            for (const char c : lit)
+            {
+                auto &cls = class_[static_cast<unsigned char>(c)];
+                if (cls == 0)
+                    cls = static_cast<std::uint8_t>(symbols_++);
+            }
+        }
+        add_state();                                       // Root
+        for (std::size_t i = 0; i < literals.size(); ++i)
+        {                                                  // Build the trie
+            std::uint32_t state = 0;
+            for (const char c : literals[i])
+            {
+                const std::size_t slot = state * symbols_ + class_[static_cast<unsigned char>(c)];
+                if (next_[slot] == kMissing)
+                {                                          // add_state grows next_ first
+                    const std::uint32_t child = add_state();
+                    next_[slot] = child;
+                }
+                state = next_[slot];
+            }
+            out_[state] = static_cast<std::int32_t>(i);
+            lengths_.push_back(literals[i].size());
+        }
+
+        // Breadth-first: failure links, output links and the missing transitions
+        std::vector<std::uint32_t> fail(out_.size(), 0);
+        std::vector<std::uint32_t> queue{0};
+        for (std::size_t head = 0; head < queue.size(); ++head)
+        {
+            const std::uint32_t s = queue[head];
+            for (std::size_t c = 0; c < symbols_; ++c)
+            {
+                auto &t = next_[s * symbols_ + c];
+                const std::uint32_t via_fail = s == 0 ? 0 : next_[fail[s] * symbols_ + c];
+                if (t == kMissing)
+                {                                          // Borrow the failure state's move
+                    t = via_fail;
+                    continue;
+                }
+                fail[t] = via_fail;
+                out_link_[t] = out_[via_fail] >= 0 ? via_fail : out_link_[via_fail];
+                queue.push_back(t);
+            }
+        }
+        for (auto &t : next_)
+        {                                                  // Flag moves into states that report
+            if (out_[t] >= 0 || out_link_[t] != 0)
+                t |= kReports;
+        }
+    }
+
+    std::size_t size() const { return lengths_.size(); } // Number of literals
+
+    // first[i] = start of the first occurrence of literal i in text, npos
+    // if none; stops as soon as every literal has been seen
+    void scan(std::string_view text, std::size_t *first) const
+    {                                                    // text: sequence bytes
+        std::fill(first, first + lengths_.size(), std::string_view::npos);
+        std::size_t remaining = lengths_.size();
+        std::uint32_t state = 0;
+        for (std::size_t i = 0; i < text.size() && remaining; ++i)
+        {
+            const std::uint32_t move = next_[state * symbols_ + class_[static_cast<unsigned char>(text[i])]];
+            state = move & ~kReports;
+            if (!(move & kReports))
+                continue;                                // Nothing ends here
+            for (std::uint32_t u = out_[state] >= 0 ? state : out_link_[state]; u != 0; u = out_link_[u])
+            {                                            // Every literal ending here
+                const auto id = static_cast<std::size_t>(out_[u]);
+                if (first[id] == std::string_view::npos)
+                {
+                    first[id] = i + 1 - lengths_[id];
+                    --remaining;
                 }
             }
         }
-        flush();        // Flush final record
-        return records; // Return records
     }
 
-    // Search sequences for a pattern
-    static std::vector<SearchHit>
-    search(const std::string &filename, // filename: input file path
-           const std::string &pattern)
-    {                                    // pattern: regex pattern
-        auto recs = parseFile(filename); // Parse FASTA file
-        std::vector<SearchHit> hits;     // Store search results
-        hits.reserve(recs.size());       // Reserve space
-        std::regex rgx(pattern);         // Create regex object
-        for (auto &p : recs)
+private:
+    static constexpr std::uint32_t kMissing = ~std::uint32_t{0};
+    static constexpr std::uint32_t kReports = std::uint32_t{1} << 31; // Set on moves into reporting states
+
+    std::uint32_t add_state()
+    {                                                    // New state with no moves yet
+        next_.resize(next_.size() + symbols_, kMissing);
+        out_.push_back(-1);
+        out_link_.push_back(0);
+        return static_cast<std::uint32_t>(out_.size() - 1);
+    }
+
+    std::array<std::uint8_t, 256> class_{}; // Byte -> symbol; 0 = in no literal
+    std::size_t symbols_ = 1;               // Symbols including class 0
+    std::vector<std::uint32_t> next_;       // state * symbols_ + symbol -> state (| kReports)
+    std::vector<std::int32_t> out_;         // Literal ending at the state, -1 if none
+    std::vector<std::uint32_t> out_link_;   // Nearest suffix state with an output; 0 = none
+    std::vector<std::size_t> lengths_;      // Literal lengths
+};
+
+// All search patterns compiled once: plain literals share one
+// LiteralMatcher pass, anything with regex syntax keeps std::regex
+class PatternSet
+{ // Multi-pattern search engine
+public:
+    explicit PatternSet(const std::vector<std::string> &patterns)
+        : literals_(split(patterns)), first_(patterns.size())
+    { // patterns: distinct search patterns
+        for (std::size_t i = 0; i < patterns.size(); ++i)
+        {                                                // Compile the rest as regexes
+            if (!is_literal(patterns[i]))
+                regexes_.emplace_back(i, std::regex(patterns[i]));
+        }
+    }
+
+    std::size_t size() const { return first_.size(); } // Number of patterns
+
+    // No regex metacharacters (the empty pattern stays a regex: it matches at 0)
+    static bool is_literal(std::string_view p)
+    {
+        return !p.empty() && p.find_first_of(".[]{}()*+?^$|\\") == std::string_view::npos;
+    }
+
+    // First match start per pattern (npos if none), valid until the next call
+    const std::vector<std::size_t> &match(std::string_view seq)
+    {                                                    // seq: one sequence
+        literals_.scan(seq, literal_first_.data());
+        for (std::size_t k = 0; k < literal_of_.size(); ++k)
+            first_[literal_of_[k]] = literal_first_[k];
+        std::cmatch m;
+        for (const auto &[i, rgx] : regexes_)
+        {                                                // One regex scan each
+            first_[i] = std::regex_search(seq.data(), seq.data() + seq.size(), m, rgx)
+                            ? static_cast<std::size_t>(m.position(0))
+                            : std::string_view::npos;
+        }
+        return first_;
+    }
+
+private:
+    // Picks out the literals for the matcher, remembering their pattern index
+    std::vector<std::string_view> split(const std::vector<std::string> &patterns)
+    {
+        std::vector<std::string_view> lits;
+        for (std::size_t i = 0; i < patterns.size(); ++i)
+        {
+            if (!is_literal(patterns[i]))
+                continue;
+            lits.push_back(patterns[i]);
+            literal_of_.push_back(i);
+        }
+        literal_first_.resize(lits.size());
+        return lits;
+    }
+
+    std::vector<std::size_t> literal_of_;                    // Literal id -> pattern index
+    std::vector<std::size_t> literal_first_;                 // Scratch for LiteralMatcher::scan
+    LiteralMatcher literals_;                                // All literals, one pass
+    std::vector<std::pair<std::size_t, std::regex>> regexes_; // Pattern index, compiled regex
+    std::vector<std::size_t> first_;                         // Result of the last match()
+};
+
+// Class for parsing and processing FASTA files
+class FastaParser
+{ // FASTA file processor
+public:
+    // Search every sequence for all patterns in one pass; emit(pattern
+    // index, const SearchHit &) per record and pattern, in record order
+    template <typename Emit>
+    static void search(const std::string &filename,           // filename: input file path
+                       const std::vector<std::string> &patterns, // patterns: as given
+                       PatternSet &engine,                     // engine: compiled patterns
+                       Emit &&emit)
+    {                                           // emit: per-hit callback
+        FastaReader reader(filename);           // Stream the file
+        for (FastaRecord rec; reader.next(rec);)
+        {                                                     // Iterate records
+            const auto &first = engine.match(rec.seq);        // All patterns at once
+            for (std::size_t i = 0; i < patterns.size(); ++i)
+            {                                                 // Report results
+                emit(i, SearchHit{rec.id, patterns[i], first[i] != std::string_view::npos, first[i]});
+            }
+        }
+    }
+
+    // Read every record into packed form (2 bits per base or 5 per residue)
+    static std::vector<PackedRecord> loadPacked(const std::string &filename)
+    {                                           // filename: input file path
+        std::vector<PackedRecord> records;
+        FastaReader reader(filename);           // Stream the file
+        for (FastaRecord rec; reader.next(rec);)
+            records.push_back(PackedRecord{std::string(rec.id), PackedSeq::pack(rec.seq)});
+        return records;
+    }
+
+    // Search packed records for one pattern; emit(const SearchHit &) per
+    // record. Literals are found on the packed codes; a regex (rgx set)
+    // runs over each record unpacked into one reused buffer.
+    template <typename Emit>
+    static void searchPacked(const std::vector<PackedRecord> &records, // records: from loadPacked
+                             const std::string &pattern,               // pattern: as given
+                             const std::regex *rgx,                    // rgx: compiled pattern, null for a literal
+                             Emit &&emit)
+    {                                                  // emit: per-record callback
+        std::string seq;                               // Unpack buffer for regexes
+        std::cmatch m;
+        for (const auto &rec : records)
         {                                              // Iterate records
-            bool m = std::regex_search(p.second, rgx); // Perform regex search
-            hits.push_back({p.first, pattern, m});     // Store result
+            std::size_t pos = std::string_view::npos;
+            if (!rgx)
+                pos = rec.seq.find(pattern);           // Packed-code search
+            else
+            {
+                seq.clear();
+                rec.seq.unpack(0, rec.seq.size(), seq);
+                const std::string_view text = seq;
+                if (std::regex_search(text.data(), text.data() + text.size(), m, *rgx))
+                    pos = static_cast<std::size_t>(m.position(0));
+            }
+            emit(SearchHit{rec.id, pattern, pos != std::string_view::npos, pos});
+        }
+    }
+
+    // Summarize sequence lengths from the .fai index; emit(const LengthInfo &) per record
+    template <typename Emit>
+    static void summary(const std::string &filename, Emit &&emit)
+    {                                           // filename: input file path
+        const FastaIndex index(filename);       // Load or build <file>.fai
+        for (const auto &e : index.entries())
+        {                                       // Iterate records
+            emit(LengthInfo{e.name, e.length}); // Report ID and length
         }
-        return hits; // Return results
     }
 
-    // Summarize sequence lengths
-    static std::vector<LengthInfo>
-    summary(const std::string &filename)
-    {                                    // filename: input file path
-        auto recs = parseFile(filename); // Parse FASTA file
-        std::vector<LengthInfo> lens;    // Store length info
-        lens.reserve(recs.size());       // Reserve space
-        for (auto &p : recs)
-        {                                               // Iterate records
-            lens.push_back({p.first, p.second.size()}); // Store ID and length
+    // Residue counts per record in one streaming pass; emit(id, counts)
+    // per record. Returns the file totals and appends each record's
+    // length to lengths (for N50).
+    template <typename Emit>
+    static residue_counts::Counts composition(const std::string &filename,      // filename: input file path
+                                              std::vector<std::uint64_t> &lengths, // lengths: record lengths
+                                              Emit &&emit)
+    {                                           // emit: per-record callback
+        residue_counts::Counts file;            // Whole-file totals
+        FastaReader reader(filename);           // Stream the file
+        for (FastaRecord rec; reader.next(rec);)
+        {                                             // Iterate records
+            residue_counts::Counts counts;
+            residue_counts::count(rec.seq, counts);   // Byte histogram kernel
+            counts.low_complexity = counts.nucleotide() ? low_complexity::count_dust(rec.seq)
+                                                        : low_complexity::count_seg(rec.seq);
+            lengths.push_back(rec.seq.size());
+            emit(rec.id, counts);                     // Report composition
+            file += counts;
         }
-        return lens; // Return results
+        return file;
+    }
+
+    // Fetch ID or ID:start-end (1-based, inclusive) for each request;
+    // emit(request, sequence) in request order. Returns which were found.
+    template <typename Emit>
+    static std::vector<bool> getSequences(const std::string &filename,          // filename: input file path
+                                          const std::vector<std::string> &requests, // requests: IDs / regions
+                                          Emit &&emit)
+    {                                                  // emit: per-request callback
+        const FastaIndex index(filename);              // Load or build <file>.fai
+        std::vector<Region> regions(requests.size());  // Resolved requests
+        std::vector<std::optional<std::string>> seqs(requests.size());
+        std::unordered_map<std::string_view, std::vector<std::size_t>> pending; // ID -> requests to stream
+        for (std::size_t i = 0; i < requests.size(); ++i)
+        {                                              // Offset reads first
+            const auto region = parseRegion(index, requests[i]);
+            if (!region)
+                continue;                              // Unknown ID or bad range
+            regions[i] = *region;
+            seqs[i] = index.fetch(*region->entry, region->begin, region->end);
+            if (!seqs[i])
+                pending[region->entry->name].push_back(i); // Irregular plain lines / non-BGZF
+        }
+        if (!pending.empty())
+        {                                              // One streaming pass for the rest
+            FastaReader reader(filename);
+            for (FastaRecord rec; !pending.empty() && reader.next(rec);)
+            {
+                const auto it = pending.find(rec.id);
+                if (it == pending.end())
+                    continue;
+                for (const std::size_t i : it->second)
+                {                                      // First record with the ID wins
+                    seqs[i] = std::string(rec.seq.substr(regions[i].begin, regions[i].end - regions[i].begin));
+                }
+                pending.erase(it);
+            }
+        }
+        std::vector<bool> found(requests.size());
+        for (std::size_t i = 0; i < requests.size(); ++i)
+        {                                              // Report in request order
+            if (!seqs[i])
+                continue;
+            found[i] = true;
+            emit(requests[i], *seqs[i]);
+        }
+        return found;
+    }
+
+private:
+    // A record plus a 0-based half-open base range
+    struct Region
+    {                                   // Resolved request
+        const FaiEntry *entry = nullptr; // Index entry
+        std::uint64_t begin = 0;         // First base
+        std::uint64_t end = 0;           // One past the last base
+    };
+
+    // An exact ID wins, so IDs containing ':' still work; otherwise the text
+    // after the last ':' is start-end, or start alone for the rest of the
+    // record (1-based, inclusive, as in samtools regions)
+    static std::optional<Region> parseRegion(const FastaIndex &index, std::string_view request)
+    {                                                      // request: ID[:start-end]
+        if (const auto *e = index.find(request))
+            return Region{e, 0, e->length};                // Whole record
+        const auto colon = request.rfind(':');
+        if (colon == std::string_view::npos)
+            return std::nullopt;
+        const auto *e = index.find(request.substr(0, colon));
+        if (!e)
+            return std::nullopt;
+        const auto range = request.substr(colon + 1);
+        std::uint64_t start = 0, stop = e->length;
+        const char *const last = range.data() + range.size();
+        auto [p, err] = std::from_chars(range.data(), last, start);
+        if (err != std::errc{} || start == 0 || start > e->length)
+            return std::nullopt;                           // Not a range inside the record
+        if (p != last)
+        {                                                  // "-end" or a trailing "-"
+            if (*p++ != '-')
+                return std::nullopt;
+            if (p != last)
+            {
+                const auto [q, err2] = std::from_chars(p, last, stop);
+                if (err2 != std::errc{} || q != last || stop < start)
+                    return std::nullopt;
+            }
+        }
+        return Region{e, start - 1, std::min(stop, e->length)};
     }
 };
 
@@ -124,16 +856,28 @@ static void usage_quick(const std::string &prog)
 { // prog: program name
     std::cout << "Usage:\n"
               << "  " << prog << " --search <FILES and PATTERNS in any order>\n"
-              << "  " << prog << " --summary <FILES...>\n\n"
+              << "  " << prog << " --summary <FILES...>\n"
+              << "  " << prog << " --get-seq <FILES and IDs[:start-end] in any order>\n"
+              << "  " << prog << " --composition <FILES...> [--output FILE.tab]\n"
+              << "  " << prog << " --query <FILES...>   (patterns from stdin, one per line)\n\n"
               << "Examples:\n"
               << "  " << prog << " --search sars-cov1.fasta \"MAT\"\n"
               << "  " << prog << " --search \"sp|P59637|VEMP_CVHSA\" sars-cov2.fasta sars-cov1.fasta\n"
               << "  " << prog << " --search sars-cov1.fasta sars-cov2.fasta \"A.T\" \"MAT\"\n"
-              << "  " << prog << " --summary sars-cov1.fasta sars-cov2.fasta\n\n"
+              << "  " << prog << " --summary sars-cov1.fasta sars-cov2.fasta\n"
+              << "  " << prog << " --get-seq sars-cov1.fasta \"sp|P59637|VEMP_CVHSA:1-20\"\n"
+              << "  " << prog << " --composition sars-cov1.fasta sars-cov2.fasta --output composition.tab\n"
+              << "  " << prog << " --query sars-cov1.fasta sars-cov2.fasta < patterns.txt\n\n"
               << "Notes:\n"
-              << "  - Files must have .fasta or .fasta.gz extension (case-insensitive).\n"
+              << "  - Files must have .fasta or .fasta.gz extension (case-insensitive); any other\n"
+              << "    argument that is not an existing file is a pattern or ID (e.g. \"A.T\", NC_045512.2).\n"
               << "  - Patterns are regular expressions; quote patterns with '|'.\n"
               << "  - Search concatenates sequence lines, ignoring line breaks.\n"
+              << "  - Matches print the 1-based position of the first hit; plain-text patterns\n"
+              << "    are searched together in one pass, the rest as regular expressions.\n"
+              << "  - --summary and --get-seq use <file>.fai (samtools faidx layout), built on first use.\n"
+              << "  - --query keeps the files in memory packed (2 bits per base, 5 per amino acid)\n"
+              << "    and answers each stdin pattern with --search rows.\n"
               << "Run '" << prog << " --help' for detailed options.\n";
 }
 
@@ -164,14 +908,6 @@ static bool has_fasta_ext(const std::string &path)
            ends_with_ci(path, ".fasta.gz"); // Check .fasta.gz extension
 }
 
-// Check if string resembles a file path
-static bool looks_like_path(const std::string &s)
-{                                               // s: input string
-    return s.find('/') != std::string::npos ||  // Check for slashes
-           s.find('\\') != std::string::npos || // Check for backslashes
-           s.find('.') != std::string::npos;    // Check for dots
-}
-
 // Extract extension after last dot
 static std::string ext_after_last_dot(const std::string &s)
 {                                                                          // s: input string
@@ -194,16 +930,16 @@ static Split split_tokens(const std::vector<std::string> &tokens)
     Split out;                                                 // Result structure
     std::unordered_set<std::string> seen_files, seen_patterns; // Track unique files, patterns
 
+    // A token is a file only when it has a FASTA extension or names an
+    // existing file; everything else, dots and backslashes included
+    // ("A.T", "\\d+", "NC_045512.2:1-100"), is a pattern or ID
     for (const auto &t : tokens)
     { // Iterate tokens
-        if (looks_like_path(t))
-        { // Check if path-like
-            if (!has_fasta_ext(t))
-            {                                             // Check FASTA extension
-                out.files_invalid_wrong_ext.push_back(t); // Add invalid extension
-                continue;                                 // Skip to next token
-            }
-            if (fs::exists(t) && fs::is_regular_file(t))
+        std::error_code ec;
+        const bool on_disk = fs::is_regular_file(t, ec); // Existing file
+        if (has_fasta_ext(t))
+        { // FASTA file argument
+            if (on_disk)
             {                                     // Check file existence
                 if (seen_files.insert(t).second)  // Check if unique
                     out.files_valid.push_back(t); // Add valid file
@@ -213,6 +949,10 @@ static Split split_tokens(const std::vector<std::string> &tokens)
                 out.files_invalid_missing.push_back(t); // Add missing file
             }
         }
+        else if (on_disk)
+        {                                             // A file, but not FASTA
+            out.files_invalid_wrong_ext.push_back(t); // Add invalid extension
+        }
         else
         {                                       // Treat as pattern
             if (seen_patterns.insert(t).second) // Check if unique
@@ -222,6 +962,103 @@ static Split split_tokens(const std::vector<std::string> &tokens)
     return out; // Return results
 }
 
+// Report tokens with a wrong extension and files that do not exist
+static void report_file_problems(const Split &split, const std::string &prog)
+{ // split: classified tokens, prog: program name
+    if (!split.files_invalid_wrong_ext.empty())
+    { // Check wrong extensions
+        for (const auto &f : split.files_invalid_wrong_ext)
+        { // Iterate invalid files
+            std::cerr << "Error: invalid FASTA file " << f
+                      << " (.fasta or .fasta.gz required).\n"; // Output error
+            const std::string ext = ext_after_last_dot(f);     // Get extension
+            std::cerr << "Extension: " << (ext.empty() ? "(none)" : "." + ext) << "\n";
+        }
+        std::cerr << "\n"; // Newline
+        usage_quick(prog); // Show usage
+        std::cerr << "\n"; // Newline
+    }
+    if (!split.files_invalid_missing.empty())
+    {                                              // Check missing files
+        std::cerr << "Warning: missing file(s): "; // Output warning
+        for (size_t i = 0; i < split.files_invalid_missing.size(); ++i)
+        { // Iterate files
+            if (i)
+                std::cerr << ", ";                                     // Add comma
+            std::cerr << "'" << split.files_invalid_missing[i] << "'"; // Output file
+        }
+        std::cerr << "\n\n"; // Newline
+    }
+}
+
+// Appends one search row: "id pattern true POS" (1-based) or "id pattern false"
+static void append_search_row(std::string &row, const SearchHit &hit)
+{ // row: output buffer, hit: result
+    row.append(hit.id).append(" ").append(hit.pattern);
+    row.append(hit.match ? " true " + std::to_string(hit.position + 1) : " false");
+    row += '\n';
+}
+
+// Shortest length among the longest records that together hold half the bases
+static std::uint64_t n50(std::vector<std::uint64_t> lengths)
+{ // lengths: record lengths
+    std::sort(lengths.begin(), lengths.end(), std::greater<>());
+    std::uint64_t total = 0;
+    for (const auto n : lengths)
+        total += n;
+    std::uint64_t covered = 0;
+    for (const auto n : lengths)
+    { // Longest first
+        covered += n;
+        if (covered * 2 >= total)
+            return n;
+    }
+    return 0; // No records
+}
+
+// Appends one composition row: file, id, type, length, n50, gc_percent,
+// ambiguous, soft_masked, low_complexity, then counts for A..Z and other
+// bytes. Sequences that are >= 90% A/C/G/T/U/N are nucleotides: GC is over
+// A/C/G/T/U and every other letter is ambiguous. Otherwise protein, whose
+// ambiguity codes are B/J/X/Z. soft_masked counts lowercase residues, as
+// left by masking tools; low_complexity counts residues in a low-scoring
+// window (DUST for nucleotides, SEG's trigger for proteins, per record).
+static void append_composition_row(std::string &out,                  // out: row buffer
+                                   std::string_view file,             // file: input path
+                                   std::string_view id,               // id: record ID or "*" for the file
+                                   const residue_counts::Counts &c,   // c: residue counts
+                                   std::uint64_t n50_length)
+{ // n50_length: N50 of the row's records
+    std::uint64_t letters = 0;
+    for (const auto n : c.letter)
+        letters += n;
+    const std::uint64_t acgtu = c['A'] + c['C'] + c['G'] + c['T'] + c['U'];
+    const bool nucleotide = c.nucleotide();
+    const std::string_view type = letters == 0 ? "unknown" : !nucleotide ? "protein" : c['U'] > c['T'] ? "rna" : "dna";
+
+    char num[32];
+    auto put = [&](std::uint64_t n)
+    { // Tab + number
+        out += '\t';
+        out.append(num, std::to_chars(num, num + sizeof num, n).ptr);
+    };
+    out.append(file).append("\t").append(id).append("\t").append(type);
+    put(c.total);
+    put(n50_length);
+    out += '\t';
+    if (nucleotide && acgtu > 0)
+        out.append(num, std::to_chars(num, num + sizeof num, 100.0 * double(c['G'] + c['C']) / double(acgtu), std::chars_format::fixed, 2).ptr);
+    else
+        out += "NA"; // GC is a nucleotide measure
+    put(nucleotide ? letters - acgtu : c['B'] + c['J'] + c['X'] + c['Z']);
+    put(c.lowercase);
+    put(c.low_complexity);
+    for (const auto n : c.letter)
+        put(n);
+    put(c.total - letters);
+    out += '\n';
+}
+
 // Main program entry point
 int main(int argc, char *argv[])
 {                                                                                // argc, argv: command-line
@@ -237,6 +1074,18 @@ int main(int argc, char *argv[])
     modes.add_argument("--summary")                                           // Add summary mode
         .help("Summarize sequence lengths for files.")                        // Help text
         .nargs(argparse::nargs_pattern::at_least_one);                        // Require ≥1 argument
+    modes.add_argument("--get-seq")                                           // Add fetch mode
+        .help("Print sequences for IDs or ID:start-end regions; accepts mixed files and IDs.")
+        .nargs(argparse::nargs_pattern::at_least_one);                        // Require ≥1 argument
+    modes.add_argument("--composition")                                       // Add composition mode
+        .help("Residue composition, GC, N50, ambiguous, soft-masked and low-complexity counts per record and file.")
+        .nargs(argparse::nargs_pattern::at_least_one);                        // Require ≥1 argument
+    modes.add_argument("--query")                                             // Add packed query mode
+        .help("Load files packed into memory, then search each pattern read from stdin.")
+        .nargs(argparse::nargs_pattern::at_least_one);                        // Require ≥1 argument
+    program.add_argument("--output")                                          // Composition table path
+        .help("Write --composition rows to FILE.tab instead of stdout.")      // Help text
+        .default_value(std::string(""));                                      // Default: stdout
 
     try
     {                                   // Parse arguments
@@ -253,17 +1102,20 @@ int main(int argc, char *argv[])
 
     const bool mode_search = program.is_used("--search");   // Check search mode
     const bool mode_summary = program.is_used("--summary"); // Check summary mode
-    if (!mode_search && !mode_summary)
+    const bool mode_get_seq = program.is_used("--get-seq"); // Check fetch mode
+    const bool mode_composition = program.is_used("--composition"); // Check composition mode
+    const bool mode_query = program.is_used("--query");             // Check packed query mode
+    if (!mode_search && !mode_summary && !mode_get_seq && !mode_composition && !mode_query)
     {                       // No mode specified
         print_banner(prog); // Show banner
         usage_quick(prog);  // Show usage
         return 0;           // Exit successfully
     }
-    if (mode_search && mode_summary)
-    {                                                                              // Both modes used
-        std::cerr << "Error: --search and --summary cannot be used together.\n\n"; // Output error
-        usage_quick(prog);                                                         // Show usage
-        return 1;                                                                  // Exit with error
+    if (mode_search + mode_summary + mode_get_seq + mode_composition + mode_query > 1)
+    {                                                                                                                   // Several modes used
+        std::cerr << "Error: --search, --summary, --get-seq, --composition and --query cannot be used together.\n\n"; // Output error
+        usage_quick(prog);                                                                    // Show usage
+        return 1;                                                                             // Exit with error
     }
 
     try
@@ -273,30 +1125,7 @@ int main(int argc, char *argv[])
             const auto raw = program.get<std::vector<std::string>>("--search"); // Get arguments
             const auto split = split_tokens(raw);                               // Split into files/patterns
 
-            if (!split.files_invalid_wrong_ext.empty())
-            { // Check wrong extensions
-                for (const auto &f : split.files_invalid_wrong_ext)
-                { // Iterate invalid files
-                    std::cerr << "Error: invalid FASTA file " << f
-                              << " (.fasta or .fasta.gz required).\n"; // Output error
-                    const std::string ext = ext_after_last_dot(f);     // Get extension
-                    std::cerr << "Extension: " << (ext.empty() ? "(none)" : "." + ext) << "\n";
-                }
-                std::cerr << "\n"; // Newline
-                usage_quick(prog); // Show usage
-                std::cerr << "\n"; // Newline
-            }
-            if (!split.files_invalid_missing.empty())
-            {                                              // Check missing files
-                std::cerr << "Warning: missing file(s): "; // Output warning
-                for (size_t i = 0; i < split.files_invalid_missing.size(); ++i)
-                { // Iterate files
-                    if (i)
-                        std::cerr << ", ";                                     // Add comma
-                    std::cerr << "'" << split.files_invalid_missing[i] << "'"; // Output file
-                }
-                std::cerr << "\n\n"; // Newline
-            }
+            report_file_problems(split, prog); // Wrong extensions / missing files
 
             if (split.files_valid.empty())
             {             // No valid files
@@ -314,24 +1143,36 @@ int main(int argc, char *argv[])
                 std::cout << "Valid file: " << vf << "\n"; // Output valid file
             }
 
+            PatternSet engine(split.patterns); // Compile every pattern once
             for (const auto &file : split.files_valid)
-            {                                             // Iterate files
-                auto recs = FastaParser::parseFile(file); // Parse file
-                for (const auto &pattern : split.patterns)
-                {                            // Iterate patterns
-                    std::regex rgx(pattern); // Create regex
-                    for (const auto &rec : recs)
-                    {                                                      // Iterate records
-                        const std::string &sid = rec.first;                // Get sequence ID
-                        const std::string &sseq = rec.second;              // Get sequence
-                        const bool matched = std::regex_search(sseq, rgx); // Search
-                        std::cout << sid << " " << pattern << " "
-                                  << (matched ? "true" : "false") << "\n"; // Output result
-                    }
+            { // Iterate files, one pass each
+                // Rows come out pattern by pattern: the first pattern's go
+                // straight to stdout, the others wait in temporary files
+                std::vector<std::unique_ptr<std::FILE, int (*)(std::FILE *)>> spill;
+                for (std::size_t i = 1; i < split.patterns.size(); ++i)
+                {                                        // One spill file per later pattern
+                    spill.emplace_back(std::tmpfile(), &std::fclose);
+                    if (!spill.back())
+                        throw std::runtime_error("Cannot create temporary file");
+                }
+                FastaParser::search(file, split.patterns, engine, [&](std::size_t i, const SearchHit &hit)
+                                    {
+                                        std::string row;
+                                        append_search_row(row, hit);
+                                        if (i == 0)
+                                            std::cout << row; // Output result
+                                        else
+                                            std::fwrite(row.data(), 1, row.size(), spill[i - 1].get()); });
+                for (const auto &f : spill)
+                {                                        // Later patterns, in order
+                    std::rewind(f.get());
+                    char buf[1 << 16];
+                    for (std::size_t n; (n = std::fread(buf, 1, sizeof buf, f.get())) > 0;)
+                        std::cout.write(buf, static_cast<std::streamsize>(n));
                 }
             }
         }
-        else
+        else if (mode_summary)
         {                                                                        // Handle summary mode
             const auto raw = program.get<std::vector<std::string>>("--summary"); // Get arguments
             const auto split = split_tokens(raw);                                // Split into files/patterns
@@ -342,42 +1183,178 @@ int main(int argc, char *argv[])
                 usage_quick(prog);                                             // Show usage
                 return 1;                                                      // Exit with error
             }
-            if (!split.files_invalid_wrong_ext.empty())
-            { // Check wrong extensions
-                for (const auto &f : split.files_invalid_wrong_ext)
-                { // Iterate invalid files
-                    std::cerr << "Error: invalid FASTA file " << f
-                              << " (.fasta or .fasta.gz required).\n"; // Output error
-                    const std::string ext = ext_after_last_dot(f);     // Get extension
-                    std::cerr << "Extension: " << (ext.empty() ? "(none)" : "." + ext) << "\n";
+            report_file_problems(split, prog); // Wrong extensions / missing files
+            if (split.files_valid.empty())
+            {             // No valid files
+                return 1; // Exit with error
+            }
+
+            for (const auto &f : split.files_valid)
+            { // Iterate files
+                FastaParser::summary(f, [](const LengthInfo &li)
+                                     { std::cout << li.id << " " << li.length << "\n"; }); // Output result
+            }
+        }
+        else if (mode_query)
+        {                                                                      // Handle packed query mode
+            const auto raw = program.get<std::vector<std::string>>("--query"); // Get arguments
+            const auto split = split_tokens(raw);                              // Split into files/patterns
+
+            if (!split.patterns.empty())
+            {                                                                                   // Check for patterns
+                std::cerr << "Error: --query reads patterns from stdin, one per line.\n\n"; // Output error
+                usage_quick(prog);                                                              // Show usage
+                return 1;                                                                       // Exit with error
+            }
+            report_file_problems(split, prog); // Wrong extensions / missing files
+            if (split.files_valid.empty())
+            {             // No valid files
+                return 1; // Exit with error
+            }
+
+            std::vector<std::vector<PackedRecord>> sets; // Per file, in argument order
+            std::size_t records = 0, residues = 0, bytes = 0;
+            for (const auto &f : split.files_valid)
+            {                                          // Load each file once
+                std::cout << "Valid file: " << f << "\n"; // Output valid file
+                sets.push_back(FastaParser::loadPacked(f));
+                for (const auto &rec : sets.back())
+                {                                      // Memory held
+                    ++records;
+                    residues += rec.seq.size();
+                    bytes += rec.seq.packed_bytes();
+                }
+            }
+            std::cerr << "Loaded " << records << " record(s), " << residues << " residue(s) in "
+                      << bytes << " packed byte(s)\n";
+            std::cout << std::flush;
+
+            for (std::string pattern; std::getline(std::cin, pattern);)
+            { // One search per stdin line
+                if (!pattern.empty() && pattern.back() == '\r')
+                    pattern.pop_back(); // CRLF input
+                if (pattern.empty())
+                    continue;
+                std::optional<std::regex> rgx;
+                if (!PatternSet::is_literal(pattern))
+                {
+                    try
+                    {
+                        rgx.emplace(pattern); // Compile once for every file
+                    }
+                    catch (const std::regex_error &e)
+                    {                                                                             // Keep serving
+                        std::cerr << "Error: invalid pattern '" << pattern << "': " << e.what() << "\n"; // Output error
+                        continue;
+                    }
                 }
-                std::cerr << "\n"; // Newline
-                usage_quick(prog); // Show usage
-                std::cerr << "\n"; // Newline
-            }
-            if (!split.files_invalid_missing.empty())
-            {                                              // Check missing files
-                std::cerr << "Warning: missing file(s): "; // Output warning
-                for (size_t i = 0; i < split.files_invalid_missing.size(); ++i)
-                { // Iterate files
-                    if (i)
-                        std::cerr << ", ";                                     // Add comma
-                    std::cerr << "'" << split.files_invalid_missing[i] << "'"; // Output file
+                std::string rows;
+                for (const auto &set : sets)
+                {
+                    FastaParser::searchPacked(set, pattern, rgx ? &*rgx : nullptr, [&](const SearchHit &hit)
+                                              { append_search_row(rows, hit); });
                 }
-                std::cerr << "\n\n"; // Newline
+                std::cout << rows << std::flush; // Answer before reading the next line
             }
+        }
+        else if (mode_composition)
+        {                                                                            // Handle composition mode
+            const auto raw = program.get<std::vector<std::string>>("--composition"); // Get arguments
+            const auto split = split_tokens(raw);                                    // Split into files/patterns
+            const auto output = program.get<std::string>("--output");               // Optional FILE.tab
+
+            if (!split.patterns.empty())
+            {                                                                      // Check for patterns
+                std::cerr << "Error: --composition does not accept patterns.\n\n"; // Output error
+                usage_quick(prog);                                                 // Show usage
+                return 1;                                                          // Exit with error
+            }
+            report_file_problems(split, prog); // Wrong extensions / missing files
             if (split.files_valid.empty())
             {             // No valid files
                 return 1; // Exit with error
             }
+            if (!output.empty() && !ends_with_ci(output, ".tab"))
+            {                                                    // Check output extension
+                std::cerr << "Error: --output must end with .tab\n"; // Output error
+                return 1;                                        // Exit with error
+            }
+            std::ofstream file_out;
+            if (!output.empty())
+            {                                                                   // Open output table
+                file_out.open(output, std::ios::binary | std::ios::trunc);
+                if (!file_out)
+                {
+                    std::cerr << "Error: cannot open output: " << output << "\n"; // Output error
+                    return 1;                                                     // Exit with error
+                }
+            }
+            std::ostream &out = output.empty() ? std::cout : file_out;
 
+            std::string rows = "file\tid\ttype\tlength\tn50\tgc_percent\tambiguous\tsoft_masked\tlow_complexity";
+            for (char c = 'A'; c <= 'Z'; ++c)
+                rows.append("\t").append(1, c);
+            rows += "\tother\n";
             for (const auto &f : split.files_valid)
-            {                                        // Iterate files
-                auto lens = FastaParser::summary(f); // Get lengths
-                for (auto &li : lens)
-                {                                                   // Iterate results
-                    std::cout << li.id << " " << li.length << "\n"; // Output result
-                }
+            { // One pass per file: a row per record, then the file total ("*")
+                std::vector<std::uint64_t> lengths;
+                const auto total = FastaParser::composition(f, lengths, [&](std::string_view id, const residue_counts::Counts &c)
+                                                            {
+                                                                append_composition_row(rows, f, id, c, c.total);
+                                                                if (rows.size() >= (std::size_t{1} << 20))
+                                                                { // Write in large blocks
+                                                                    out.write(rows.data(), static_cast<std::streamsize>(rows.size()));
+                                                                    rows.clear();
+                                                                } });
+                append_composition_row(rows, f, "*", total, n50(std::move(lengths)));
+            }
+            out.write(rows.data(), static_cast<std::streamsize>(rows.size()));
+            if (!out.flush())
+            {                                                         // Disk full etc.
+                std::cerr << "Error: writing composition table failed\n"; // Output error
+                return 1;                                             // Exit with error
+            }
+        }
+        else
+        {                                                                        // Handle fetch mode
+            const auto raw = program.get<std::vector<std::string>>("--get-seq"); // Get arguments
+            const auto split = split_tokens(raw);                                // Split into files/IDs
+
+            report_file_problems(split, prog); // Wrong extensions / missing files
+            if (split.files_valid.empty())
+            {             // No valid files
+                return 1; // Exit with error
+            }
+            if (split.patterns.empty())
+            {                                                                  // No IDs
+                std::cerr << "Error: --get-seq requires at least one ID.\n\n"; // Output error
+                usage_quick(prog);                                             // Show usage
+                return 1;                                                      // Exit with error
+            }
+
+            std::vector<bool> found(split.patterns.size()); // Found in any file
+            for (const auto &f : split.files_valid)
+            { // Iterate files
+                const auto hits = FastaParser::getSequences(f, split.patterns, [](const std::string &request, const std::string &seq)
+                                                            { std::cout << ">" << request << "\n"
+                                                                        << seq << "\n"; }); // Output record
+                for (std::size_t i = 0; i < hits.size(); ++i)
+                    found[i] = found[i] || hits[i];
+            }
+
+            bool missing = false;
+            for (std::size_t i = 0; i < found.size(); ++i)
+            { // IDs no file had
+                if (found[i])
+                    continue;
+                std::cerr << (missing ? ", " : "Warning: ID(s) or region(s) not found: ")
+                          << "'" << split.patterns[i] << "'";
+                missing = true;
+            }
+            if (missing)
+            {                        // Partial result
+                std::cerr << "\n";   // Newline
+                return 1;            // Exit with error
             }
         }
     }
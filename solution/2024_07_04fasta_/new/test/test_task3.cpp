@@ -1,4 +1,6 @@
 #include "test_helpers.hpp"
+#include <cstdint>
+#include <fstream>
 #include <string>
 #include <iostream>
 
@@ -17,12 +19,94 @@ int main()
     // Should have at least one 'true' (MAT present)
     assert_true(out.find("true") != std::string::npos, "Task3 search at least one match");
 
+    // Literals and regexes in one pass: rows per pattern, 1-based first-match position
+    out = run_capture("./FastaParser3 --search test/data/sars_mock1.fasta MAT \"G+C\" QQ", code);
+    assert_contains(out, "sp|P22222|TEST2_SAMPLE1 MAT true 8\n", "Task3 literal match position");
+    assert_contains(out, "sp|P33333|TEST3_SAMPLE1 MAT false\nsp|P11111|TEST1_SAMPLE1 G+C true 10\n", "Task3 pattern order kept");
+    assert_contains(out, "sp|P33333|TEST3_SAMPLE1 QQ true 1\n", "Task3 later literal");
+
+    // Packed in-memory query: stdin patterns give the same rows as --search
+    out = run_capture("printf 'MAT\\nG+C\\nQQ\\n' | ./FastaParser3 --query test/data/sars_mock1.fasta", code);
+    assert_contains(out, "sp|P22222|TEST2_SAMPLE1 MAT true 8\n", "Task3 query literal on packed sequence");
+    assert_contains(out, "sp|P33333|TEST3_SAMPLE1 MAT false\nsp|P11111|TEST1_SAMPLE1 G+C true 10\n", "Task3 query regex on unpacked sequence");
+    assert_contains(out, "sp|P33333|TEST3_SAMPLE1 QQ true 1\n", "Task3 query later pattern");
+
+    // Tokens with dots or backslashes are patterns unless they name a FASTA file
+    out = run_capture("./FastaParser3 --search test/data/sars_mock1.fasta A.T \"\\\\d+\" MAT", code);
+    assert_contains(out, "sp|P22222|TEST2_SAMPLE1 A.T true 9\n", "Task3 regex with a dot is a pattern");
+    assert_contains(out, "sp|P11111|TEST1_SAMPLE1 \\d+ false\n", "Task3 regex with a backslash is a pattern");
+
     // Summary across two files
     out = run_capture("./FastaParser3 --summary test/data/sars_mock1.fasta test/data/sars_mock2.fasta", code);
     // Expect sequence IDs present
     assert_contains(out, "sp|P11111|TEST1_SAMPLE1", "Task3 summary id1");
     assert_contains(out, "sp|X00001|ALPHA_SAMPLE2", "Task3 summary id2");
 
+    // Compressed inputs: BGZF (mock1) and plain gzip (mock2)
+    out = run_capture("./FastaParser3 --summary test/data/sars_mock1.fasta.gz test/data/sars_mock2.fasta.gz", code);
+    assert_contains(out, "sp|P11111|TEST1_SAMPLE1", "Task3 summary id1 from .fasta.gz");
+    assert_contains(out, "sp|X00001|ALPHA_SAMPLE2", "Task3 summary id2 from .fasta.gz");
+
+    // Streamed lengths do not depend on the codec
+    const auto plain = run_capture("./FastaParser3 --summary test/data/sars_mock1.fasta", code);
+    const auto gz = run_capture("./FastaParser3 --summary test/data/sars_mock1.fasta.gz", code);
+    assert_contains(plain, "sp|P22222|TEST2_SAMPLE1 16", "Task3 summary length");
+    assert_true(plain == gz, "Task3 summary identical for .fasta and .fasta.gz");
+
+    // Indexed fetch: whole record and a 1-based inclusive region, plain and BGZF
+    out = run_capture("./FastaParser3 --get-seq test/data/sars_mock1.fasta \"sp|P22222|TEST2_SAMPLE1:5-9\" \"sp|P33333|TEST3_SAMPLE1\"", code);
+    assert_contains(out, ">sp|P22222|TEST2_SAMPLE1:5-9\nCCCMA\n", "Task3 get-seq region");
+    assert_contains(out, ">sp|P33333|TEST3_SAMPLE1\nQQQQQQQQ\n", "Task3 get-seq whole record");
+    out = run_capture("./FastaParser3 --get-seq test/data/sars_mock1.fasta.gz \"sp|P22222|TEST2_SAMPLE1:5-9\"", code);
+    assert_contains(out, "CCCMA", "Task3 get-seq region from BGZF");
+
+    // Versioned accessions: the dot belongs to the ID, with or without a region
+    out = run_capture("./FastaParser3 --get-seq test/data/versioned.fasta NC_045512.2:11-20 MN908947.3", code);
+    assert_contains(out, ">NC_045512.2:11-20\nTATACCTTCC\n", "Task3 get-seq dotted ID region");
+    assert_contains(out, ">MN908947.3\nGGGGCCCCAA\n", "Task3 get-seq dotted ID whole record");
+
+    // Uneven line lengths: no samtools layout, so no .fai; lengths and fetches still work
+    out = run_capture("./FastaParser3 --summary test/data/irregular.fasta 2>/dev/null; test -e test/data/irregular.fasta.fai || echo no-fai", code);
+    assert_contains(out, "irr1 21\nreg1 6\nno-fai\n", "Task3 irregular lines indexed in memory only");
+    out = run_capture("./FastaParser3 --get-seq test/data/irregular.fasta irr1:8-12 2>/dev/null", code);
+    assert_contains(out, ">irr1:8-12\nTACGA\n", "Task3 get-seq streams irregular records");
+
+    // Multi-block BGZF (40-byte blocks): regular and uneven records read the
+    // same without a .gzi, with the one that run writes, and with a stale one
+    const std::string mb = " reg1:8-45 irr1:12-40 reg2:9-12 2>/dev/null";
+    const auto mb_plain = run_capture("./FastaParser3 --get-seq test/data/multiblock.fasta" + mb, code);
+    assert_contains(mb_plain, ">reg1:8-45\nTACGGGGCCCCTTAAAACCCCGGTTTTAAAACCGATTA\n>irr1:12-40\nTACGGGGCCCCTTAAAACCCCGGTTTTAA\n>reg2:9-12\nGGCC\n",
+                    "Task3 get-seq regions across lines");
+    out = run_capture("rm -f test/data/multiblock.fasta.gz.gzi; ./FastaParser3 --get-seq test/data/multiblock.fasta.gz" + mb, code);
+    assert_true(out == mb_plain, "Task3 multi-block BGZF without .gzi");
+    run_capture("cp test/data/multiblock.fasta.gz.gzi multiblock.gzi", code);
+    assert_true(code == 0, "Task3 multi-block BGZF .gzi written");
+    out = run_capture("./FastaParser3 --get-seq test/data/multiblock.fasta.gz" + mb, code);
+    assert_true(out == mb_plain, "Task3 multi-block BGZF with .gzi");
+    {
+        // Two entries whose offsets do not land on this file's members
+        const std::uint64_t stale[] = {2, 60, 40, 120, 80};
+        std::ofstream("test/data/multiblock.fasta.gz.gzi", std::ios::binary).write(reinterpret_cast<const char *>(stale), sizeof stale);
+    }
+    out = run_capture("./FastaParser3 --get-seq test/data/multiblock.fasta.gz" + mb, code);
+    assert_true(out == mb_plain, "Task3 multi-block BGZF with a stale .gzi");
+    run_capture("cmp -s multiblock.gzi test/data/multiblock.fasta.gz.gzi; s=$?; rm -f multiblock.gzi; exit $s", code);
+    assert_true(code == 0, "Task3 stale .gzi rewritten");
+
+    // Composition table: header, per-record row and the file total row
+    out = run_capture("./FastaParser3 --composition test/data/sars_mock1.fasta", code);
+    assert_contains(out, "file\tid\ttype\tlength\tn50\tgc_percent\tambiguous\tsoft_masked\tlow_complexity\tA", "Task3 composition header");
+    assert_contains(out, "test/data/sars_mock1.fasta\tsp|P33333|TEST3_SAMPLE1\tprotein\t8\t8\tNA", "Task3 composition record row");
+    assert_contains(out, "test/data/sars_mock1.fasta\t*\tprotein\t39\t15\tNA", "Task3 composition total row");
+    // Low complexity: DUST finds the poly-A run, SEG the poly-Q run, random DNA has none
+    out = run_capture("./FastaParser3 --composition test/data/low_complexity.fasta", code);
+    assert_contains(out, "\tpolyA\tdna\t170\t170\t30.59\t0\t0\t46\t", "Task3 composition DUST count");
+    assert_contains(out, "\tpolyQ\tprotein\t80\t80\tNA\t0\t0\t31\t", "Task3 composition SEG count");
+    assert_contains(out, "\tplain\tdna\t120\t120\t43.33\t0\t0\t0\t", "Task3 composition random DNA not low complexity");
+    assert_contains(out, "\t*\tprotein\t370\t120\tNA\t0\t0\t77\t", "Task3 composition low-complexity total");
+    out = run_capture("./FastaParser3 --composition test/data/sars_mock1.fasta --output comp.txt 2>&1", code);
+    assert_contains(out, "--output must end with .tab", "Task3 composition rejects non-.tab output");
+
     // Missing file warning
     out = run_capture("./FastaParser3 --summary test/data/NO_SUCH.fasta", code);
     assert_contains(out, "Warning", "Task3 missing file warning");
@@ -69,7 +69,7 @@ bool OBOParser::parseFile(const std::string &filename) {
       continue;
 
     if (line == "[Term]") {
-      if (in_term && !current_term.id.empty()) {
+      if (in_term && current_term.id.valid()) {
         terms.push_back(current_term);
         term_map[current_term.id] = current_term;
         term_count++;
@@ -91,7 +91,7 @@ bool OBOParser::parseFile(const std::string &filename) {
       continue;
 
     if (line.find("id:") == 0) {
-      current_term.id = extractValue(line, "id");
+      current_term.id = GoId::parse(extractValue(line, "id"));
     } else if (line.find("name:") == 0) {
       current_term.name = extractValue(line, "name");
     } else if (line.find("namespace:") == 0) {
@@ -100,30 +100,30 @@ bool OBOParser::parseFile(const std::string &filename) {
       std::string value = extractValue(line, "is_obsolete");
       current_term.is_obsolete = (value == "true");
     } else if (line.find("consider:") == 0) {
-      std::string consider_id = extractValue(line, "consider");
-      if (!consider_id.empty()) {
+      GoId consider_id = GoId::parse(extractValue(line, "consider"));
+      if (consider_id.valid()) {
         current_term.consider.push_back(consider_id);
       }
     } else if (line.find("replaced_by:") == 0) {
-      std::string replaced_id = extractValue(line, "replaced_by");
-      if (!replaced_id.empty()) {
+      GoId replaced_id = GoId::parse(extractValue(line, "replaced_by"));
+      if (replaced_id.valid()) {
         current_term.replaced_by.push_back(replaced_id);
       }
     } else if (line.find("is_a:") == 0) {
-      std::string is_a_id = extractGOId(line);
-      if (!is_a_id.empty()) {
+      GoId is_a_id = GoId::parse(extractGOId(line));
+      if (is_a_id.valid()) {
         current_term.is_a.push_back(is_a_id);
       }
     } else if (line.find("relationship: part_of") == 0) {
-      std::string part_of_id = extractGOId(line);
-      if (!part_of_id.empty()) {
+      GoId part_of_id = GoId::parse(extractGOId(line));
+      if (part_of_id.valid()) {
         current_term.part_of.push_back(part_of_id);
       }
     }
   }
 
   // Add the last term
-  if (in_term && !current_term.id.empty()) {
+  if (in_term && current_term.id.valid()) {
     terms.push_back(current_term);
     term_map[current_term.id] = current_term;
   }
@@ -157,10 +157,10 @@ OBOParser::considerTable(const std::string &namespace_filter) {
   for (const auto &term : filtered_terms) {
     if (term.is_obsolete) {
       if (term.consider.empty()) {
-        table.push_back({term.id, term.name, "NA"});
+        table.push_back({term.id.str(), term.name, "NA"});
       } else {
         for (const auto &consider_id : term.consider) {
-          table.push_back({term.id, term.name, consider_id});
+          table.push_back({term.id.str(), term.name, consider_id.str()});
         }
       }
     }
@@ -177,10 +177,10 @@ OBOParser::replacedByTable(const std::string &namespace_filter) {
   for (const auto &term : filtered_terms) {
     if (term.is_obsolete) {
       if (term.replaced_by.empty()) {
-        table.push_back({term.id, term.name, "NA"});
+        table.push_back({term.id.str(), term.name, "NA"});
       } else {
         for (const auto &replaced_id : term.replaced_by) {
-          table.push_back({term.id, term.name, replaced_id});
+          table.push_back({term.id.str(), term.name, replaced_id.str()});
         }
       }
     }
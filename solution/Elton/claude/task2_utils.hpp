@@ -8,15 +8,17 @@
 #include <string>
 #include <vector>
 
+#include "go_id.hpp" // shared 4-byte GO id (../../../include)
+
 struct GOTerm {
-  std::string id;
+  GoId id;
   std::string name;
   std::string namespace_name;
   bool is_obsolete;
-  std::vector<std::string> consider;
-  std::vector<std::string> replaced_by;
-  std::vector<std::string> is_a;
-  std::vector<std::string> part_of;
+  std::vector<GoId> consider;
+  std::vector<GoId> replaced_by;
+  std::vector<GoId> is_a;
+  std::vector<GoId> part_of;
 
   GOTerm() : is_obsolete(false) {}
 };
@@ -24,7 +26,7 @@ struct GOTerm {
 class OBOParser {
 private:
   std::vector<GOTerm> terms;
-  std::map<std::string, GOTerm> term_map;
+  std::map<GoId, GOTerm> term_map;
 
   std::string trim(const std::string &str);
   std::string extractValue(const std::string &line, const std::string &key);
@@ -40,7 +42,7 @@ public:
 
   // Getters
   const std::vector<GOTerm> &getTerms() const { return terms; }
-  const std::map<std::string, GOTerm> &getTermMap() const { return term_map; }
+  const std::map<GoId, GOTerm> &getTermMap() const { return term_map; }
 
   // Utility functions
   void printTable(const std::vector<std::vector<std::string>> &table,
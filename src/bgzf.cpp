@@ -0,0 +1,236 @@
+// bgzf.cpp — BGZF header walk, .gzi load/store, raw-deflate block inflate
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <zlib.h>
+#include "bgzf.hpp"
+#include "worker_pool.hpp"
+
+namespace
+{
+    constexpr std::size_t kHeaderBytes = 12;  // fixed gzip header up to XLEN
+    constexpr std::size_t kTrailerBytes = 8;  // CRC32 + ISIZE
+    constexpr std::size_t kBlocksPerJob = 64; // ~4 MiB of output per worker hand-off
+    constexpr std::size_t kMaxBlockBytes = std::size_t{64} << 10; // BGZF cap on a member's data
+
+    std::uint32_t le16(const char *p)
+    {
+        return std::uint32_t(std::uint8_t(p[0])) | std::uint32_t(std::uint8_t(p[1])) << 8;
+    }
+    std::uint32_t le32(const char *p)
+    {
+        return le16(p) | le16(p + 2) << 16;
+    }
+
+    // BSIZE from the "BC" extra subfield of the member at p, or 0 if there is none.
+    std::uint32_t bgzf_bsize(std::string_view buf, std::size_t p)
+    {
+        if (p + kHeaderBytes > buf.size())
+            return 0;
+        const char *h = buf.data() + p;
+        if (h[0] != '\x1f' || h[1] != '\x8b' || h[2] != 8 || !(h[3] & 4)) // deflate + FEXTRA
+            return 0;
+        const std::size_t xlen = le16(h + 10);
+        if (p + kHeaderBytes + xlen > buf.size())
+            return 0;
+        for (std::size_t x = 0; x + 4 <= xlen;)
+        {
+            const char *sub = h + kHeaderBytes + x;
+            const std::size_t slen = le16(sub + 2);
+            if (sub[0] == 'B' && sub[1] == 'C' && slen == 2 && x + 6 <= xlen)
+                return le16(sub + 4);
+            x += 4 + slen;
+        }
+        return 0;
+    }
+
+    // True when the extra field of block b leaves room for its trailer and
+    // its ISIZE is within the BGZF cap: inflate_block relies on both.
+    bool block_fits(std::string_view buf, const BgzfBlock &b)
+    {
+        const std::size_t xlen = le16(buf.data() + b.coffset + 10);
+        return kHeaderBytes + xlen + kTrailerBytes <= b.csize && b.usize <= kMaxBlockBytes;
+    }
+
+    std::string gzi_path_for(const std::string &path)
+    {
+        return path + ".gzi";
+    }
+
+    // .gzi: u64 count, then (coffset, uoffset) for every block after the first.
+    bool load_gzi(const std::string &path, std::string_view buf, std::vector<BgzfBlock> &blocks)
+    {
+        std::ifstream in(gzi_path_for(path), std::ios::binary);
+        std::uint64_t n = 0;
+        if (!in.read(reinterpret_cast<char *>(&n), sizeof n) || n > buf.size() / 28)
+            return false;
+        std::vector<std::uint64_t> pairs(2 * n);
+        if (!in.read(reinterpret_cast<char *>(pairs.data()), static_cast<std::streamsize>(pairs.size() * 8)))
+            return false;
+
+        blocks.assign(n + 1, {});
+        for (std::size_t i = 0; i < n; ++i)
+            blocks[i + 1] = {pairs[2 * i], pairs[2 * i + 1], 0, 0};
+        for (std::size_t i = 0; i <= n; ++i)
+        {
+            auto &b = blocks[i];
+            const std::uint64_t end = i < n ? blocks[i + 1].coffset : buf.size();
+            if (end <= b.coffset || end - b.coffset < kHeaderBytes + kTrailerBytes ||
+                bgzf_bsize(buf, b.coffset) + 1 != end - b.coffset)
+                return false; // stale index for a rewritten file
+            b.csize = static_cast<std::uint32_t>(end - b.coffset);
+            b.usize = le32(buf.data() + end - 4);
+            if (!block_fits(buf, b) || (i < n && b.uoffset + b.usize != blocks[i + 1].uoffset))
+                return false;
+        }
+        return true;
+    }
+
+    void store_gzi(const std::string &path, const std::vector<BgzfBlock> &blocks)
+    {
+        const std::uint64_t n = blocks.empty() ? 0 : blocks.size() - 1;
+        std::vector<std::uint64_t> words{n};
+        for (std::size_t i = 1; i < blocks.size(); ++i)
+            words.insert(words.end(), {blocks[i].coffset, blocks[i].uoffset});
+        const std::string_view bytes(reinterpret_cast<const char *>(words.data()), words.size() * sizeof words[0]);
+        replace_file(gzi_path_for(path), {&bytes, 1}); // on failure: rebuild next time
+    }
+} // namespace
+
+bool is_bgzf(std::string_view compressed)
+{
+    return bgzf_bsize(compressed, 0) != 0;
+}
+
+std::vector<BgzfBlock> index_bgzf(std::string_view compressed)
+{
+    std::vector<BgzfBlock> blocks;
+    std::uint64_t uoffset = 0;
+    for (std::size_t p = 0; p < compressed.size();)
+    {
+        const std::uint32_t bsize = bgzf_bsize(compressed, p);
+        const std::size_t csize = std::size_t{bsize} + 1;
+        if (bsize == 0 || csize < kHeaderBytes + kTrailerBytes || p + csize > compressed.size())
+            throw std::runtime_error("bgzf: malformed block at byte " + std::to_string(p));
+        const BgzfBlock block{p, uoffset, static_cast<std::uint32_t>(csize), le32(compressed.data() + p + csize - 4)};
+        if (!block_fits(compressed, block))
+            throw std::runtime_error("bgzf: malformed block at byte " + std::to_string(p));
+        blocks.push_back(block);
+        uoffset += block.usize;
+        p += csize;
+    }
+    return blocks;
+}
+
+BgzfFile::BgzfFile(const std::string &path, bool use_cache) : file_(path)
+{
+    const auto buf = file_.view();
+    if (!is_bgzf(buf))
+        throw std::runtime_error("not a BGZF file: " + path);
+    if (!use_cache || !load_gzi(path, buf, blocks_))
+    {
+        try
+        {
+            blocks_ = index_bgzf(buf);
+        }
+        catch (const std::runtime_error &e)
+        {
+            throw std::runtime_error(std::string(e.what()) + ": " + path);
+        }
+        if (use_cache)
+            store_gzi(path, blocks_);
+    }
+}
+
+std::size_t BgzfFile::block_at(std::uint64_t offset) const
+{
+    const auto it = std::upper_bound(blocks_.begin(), blocks_.end(), offset, [](std::uint64_t off, const BgzfBlock &b)
+                                     { return off < b.uoffset; });
+    return it == blocks_.begin() ? 0 : static_cast<std::size_t>(it - blocks_.begin() - 1);
+}
+
+void BgzfFile::inflate_block(std::size_t i, char *out) const
+{
+    const auto &b = blocks_[i];
+    const char *member = file_.view().data() + b.coffset;
+    const std::size_t payload_at = kHeaderBytes + le16(member + 10);
+
+    z_stream zs{};
+    if (inflateInit2(&zs, -15) != Z_OK) // raw deflate: the member header was parsed above
+        throw std::runtime_error("bgzf: cannot initialise decoder");
+    zs.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(member + payload_at));
+    zs.avail_in = static_cast<uInt>(b.csize - payload_at - kTrailerBytes);
+    zs.next_out = reinterpret_cast<Bytef *>(out);
+    zs.avail_out = b.usize;
+    const int rc = inflate(&zs, Z_FINISH);
+    inflateEnd(&zs);
+
+    const bool size_ok = (rc == Z_STREAM_END || (rc == Z_BUF_ERROR && b.usize == 0)) && zs.avail_out == 0;
+    const std::uint32_t crc = le32(member + b.csize - kTrailerBytes);
+    if (!size_ok || crc32(0, reinterpret_cast<const Bytef *>(out), b.usize) != crc)
+        throw std::runtime_error("bgzf: corrupt block at byte " + std::to_string(b.coffset));
+}
+
+std::string BgzfFile::read(std::uint64_t offset, std::size_t len) const
+{
+    const std::uint64_t end = std::min<std::uint64_t>(size(), offset + len);
+    std::string out;
+    if (offset >= end)
+        return out;
+    out.reserve(static_cast<std::size_t>(end - offset));
+    std::string block;
+    for (std::size_t i = block_at(offset); i < blocks_.size() && blocks_[i].uoffset < end; ++i)
+    {
+        const auto &b = blocks_[i];
+        block.resize(b.usize);
+        inflate_block(i, block.data());
+        const std::uint64_t from = std::max(offset, b.uoffset) - b.uoffset;
+        const std::uint64_t to = std::min(end, b.uoffset + b.usize) - b.uoffset;
+        out.append(block, from, to - from);
+    }
+    return out;
+}
+
+std::string BgzfFile::read_record(std::uint64_t offset, char header) const
+{
+    std::string out, block;
+    std::size_t next = 0; // where the boundary search resumes
+    for (std::size_t i = block_at(offset); i < blocks_.size(); ++i)
+    {
+        const auto &b = blocks_[i];
+        if (b.uoffset + b.usize <= offset)
+            continue;
+        block.resize(b.usize);
+        inflate_block(i, block.data());
+        out.append(block, std::max(offset, b.uoffset) - b.uoffset);
+        for (;;)
+        {
+            const auto nl = out.find('\n', next);
+            if (nl == std::string::npos || nl + 1 == out.size())
+            {
+                next = nl == std::string::npos ? out.size() : nl; // a trailing '\n' waits for the next block
+                break;
+            }
+            if (out[nl + 1] == header)
+            {
+                out.resize(nl + 1);
+                return out;
+            }
+            next = nl + 1;
+        }
+    }
+    return out;
+}
+
+std::string BgzfFile::inflate_all(unsigned threads) const
+{
+    std::string out(size(), '\0');
+    const std::size_t jobs = (blocks_.size() + kBlocksPerJob - 1) / kBlocksPerJob;
+    parallel_for_index(jobs, threads, [&](std::size_t j)
+                       {
+                           const std::size_t last = std::min(blocks_.size(), (j + 1) * kBlocksPerJob);
+                           for (std::size_t i = j * kBlocksPerJob; i < last; ++i)
+                               inflate_block(i, out.data() + blocks_[i].uoffset); });
+    return out;
+}
@@ -0,0 +1,264 @@
+// decompress.cpp — zlib / liblzma / libzstd decoders + InflateStream producer thread
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <lzma.h>
+#include <zlib.h>
+#ifdef OBO_HAVE_ZSTD
+#include <zstd.h>
+#endif
+#include "decompress.hpp"
+
+Codec detect_codec(std::string_view head)
+{
+    if (head.size() >= 2 && head[0] == '\x1f' && head[1] == '\x8b')
+        return Codec::kGzip;
+    if (head.starts_with(std::string_view("\xfd" "7zXZ\0", 6)))
+        return Codec::kXz;
+    if (head.starts_with("\x28\xb5\x2f\xfd"))
+        return Codec::kZstd;
+    return Codec::kNone;
+}
+
+Codec detect_codec_of(const std::string &path)
+{
+    char head[6] = {};
+    std::ifstream in(path, std::ios::binary);
+    in.read(head, sizeof head);
+    return detect_codec({head, static_cast<std::size_t>(in.gcount())});
+}
+
+namespace
+{
+    class GzipDecoder : public Decoder
+    {
+    public:
+        explicit GzipDecoder(std::string_view in) : rest_(in)
+        {
+            if (inflateInit2(&zs_, 15 + 32) != Z_OK) // 32: gzip or zlib header
+                throw std::runtime_error("gzip: cannot initialise decoder");
+        }
+        ~GzipDecoder() override { inflateEnd(&zs_); }
+
+        std::size_t decode(char *out, std::size_t cap) override
+        {
+            zs_.next_out = reinterpret_cast<Bytef *>(out);
+            zs_.avail_out = static_cast<uInt>(cap);
+            while (zs_.avail_out > 0 && !done_)
+            {
+                if (zs_.avail_in == 0 && !rest_.empty())
+                {
+                    // avail_in is 32-bit; feed larger inputs in slices
+                    const auto n = std::min<std::size_t>(rest_.size(), std::size_t{1} << 30);
+                    zs_.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(rest_.data()));
+                    zs_.avail_in = static_cast<uInt>(n);
+                    rest_.remove_prefix(n);
+                }
+                const int rc = inflate(&zs_, Z_NO_FLUSH);
+                if (rc == Z_STREAM_END)
+                {
+                    // Concatenated members (BGZF is one per 64 KiB block).
+                    if (zs_.avail_in == 0 && rest_.empty())
+                        done_ = true;
+                    else
+                        inflateReset(&zs_);
+                }
+                else if (rc != Z_OK)
+                    throw std::runtime_error(std::string("gzip: ") + (zs_.msg ? zs_.msg : "corrupt data"));
+                else if (zs_.avail_in == 0 && rest_.empty() && zs_.avail_out > 0)
+                    throw std::runtime_error("gzip: truncated input");
+            }
+            return cap - zs_.avail_out;
+        }
+
+    private:
+        z_stream zs_{};
+        std::string_view rest_; // input not yet handed to zlib
+        bool done_ = false;
+    };
+
+    class XzDecoder : public Decoder
+    {
+    public:
+        explicit XzDecoder(std::string_view in)
+        {
+            if (lzma_stream_decoder(&s_, UINT64_MAX, LZMA_CONCATENATED) != LZMA_OK)
+                throw std::runtime_error("xz: cannot initialise decoder");
+            s_.next_in = reinterpret_cast<const std::uint8_t *>(in.data());
+            s_.avail_in = in.size();
+        }
+        ~XzDecoder() override { lzma_end(&s_); }
+
+        std::size_t decode(char *out, std::size_t cap) override
+        {
+            s_.next_out = reinterpret_cast<std::uint8_t *>(out);
+            s_.avail_out = cap;
+            while (s_.avail_out > 0 && !done_)
+            {
+                const lzma_ret rc = lzma_code(&s_, LZMA_FINISH);
+                if (rc == LZMA_STREAM_END)
+                    done_ = true;
+                else if (rc != LZMA_OK)
+                    throw std::runtime_error("xz: corrupt or truncated data");
+            }
+            return cap - s_.avail_out;
+        }
+
+    private:
+        lzma_stream s_ = LZMA_STREAM_INIT;
+        bool done_ = false;
+    };
+
+#ifdef OBO_HAVE_ZSTD
+    class ZstdDecoder : public Decoder
+    {
+    public:
+        explicit ZstdDecoder(std::string_view in) : ctx_(ZSTD_createDCtx()), in_{in.data(), in.size(), 0}
+        {
+            if (!ctx_)
+                throw std::runtime_error("zstd: cannot initialise decoder");
+        }
+        ~ZstdDecoder() override { ZSTD_freeDCtx(ctx_); }
+
+        std::size_t decode(char *out, std::size_t cap) override
+        {
+            ZSTD_outBuffer o{out, cap, 0};
+            // Keep going after the input is consumed: a full output buffer
+            // can leave decoded data inside the context.
+            while (o.pos < cap && !done_)
+            {
+                const std::size_t rc = ZSTD_decompressStream(ctx_, &o, &in_);
+                if (ZSTD_isError(rc))
+                    throw std::runtime_error(std::string("zstd: ") + ZSTD_getErrorName(rc));
+                if (in_.pos == in_.size && o.pos < cap)
+                {
+                    // Everything is flushed; rc != 0 means the frame wants more input.
+                    if (rc != 0)
+                        throw std::runtime_error("zstd: truncated zstd frame");
+                    done_ = true;
+                }
+            }
+            return o.pos;
+        }
+
+    private:
+        ZSTD_DCtx *ctx_;
+        ZSTD_inBuffer in_;
+        bool done_ = false;
+    };
+#endif
+} // namespace
+
+std::unique_ptr<Decoder> make_decoder(Codec codec, std::string_view compressed)
+{
+    switch (codec)
+    {
+    case Codec::kGzip:
+        return std::make_unique<GzipDecoder>(compressed);
+    case Codec::kXz:
+        return std::make_unique<XzDecoder>(compressed);
+    case Codec::kZstd:
+#ifdef OBO_HAVE_ZSTD
+        return std::make_unique<ZstdDecoder>(compressed);
+#else
+        throw std::runtime_error("zstd input, but this build has no zstd support");
+#endif
+    case Codec::kNone:
+        break;
+    }
+    throw std::runtime_error("not a compressed input");
+}
+
+// ---- InflateStream ----
+
+InflateStream::InflateStream(const std::string &path) : file_(path)
+{
+    const auto codec = detect_codec(file_.view().substr(0, 6));
+    try
+    {
+        decoder_ = make_decoder(codec, file_.view());
+    }
+    catch (const std::runtime_error &e)
+    {
+        throw std::runtime_error(std::string(e.what()) + ": " + path);
+    }
+    for (std::size_t i = 0; i < kRingBlocks; ++i)
+    {
+        blocks_.push_back(std::make_unique<char[]>(kBlockBytes));
+        free_.push_back(i);
+    }
+    producer_ = std::thread([this]
+                            { produce(); });
+}
+
+InflateStream::~InflateStream()
+{
+    {
+        std::lock_guard lock(mutex_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    producer_.join();
+}
+
+void InflateStream::produce()
+{
+    try
+    {
+        for (;;)
+        {
+            std::size_t idx;
+            {
+                std::unique_lock lock(mutex_);
+                cv_.wait(lock, [this]
+                         { return stop_ || !free_.empty(); });
+                if (stop_)
+                    return;
+                idx = free_.front();
+                free_.pop_front();
+            }
+            const std::size_t n = decoder_->decode(blocks_[idx].get(), kBlockBytes);
+            {
+                std::lock_guard lock(mutex_);
+                filled_.emplace_back(idx, n);
+            }
+            cv_.notify_all();
+            if (n == 0)
+                return;
+        }
+    }
+    catch (...)
+    {
+        {
+            std::lock_guard lock(mutex_);
+            error_ = std::current_exception();
+            filled_.emplace_back(kRingBlocks, 0);
+        }
+        cv_.notify_all();
+    }
+}
+
+std::string_view InflateStream::next()
+{
+    std::unique_lock lock(mutex_);
+    if (held_ < kRingBlocks)
+    {
+        free_.push_back(held_);
+        held_ = kRingBlocks;
+        cv_.notify_all();
+    }
+    cv_.wait(lock, [this]
+             { return !filled_.empty(); });
+    const auto [idx, bytes] = filled_.front();
+    if (bytes == 0)
+    {
+        // Leave the end marker queued so further calls also return empty.
+        if (error_)
+            std::rethrow_exception(error_);
+        return {};
+    }
+    filled_.pop_front();
+    held_ = idx;
+    return {blocks_[idx].get(), bytes};
+}
@@ -0,0 +1,195 @@
+// go_graph.cpp — GoGraph construction, closures, depth and live-ancestor tables
+#include <algorithm>
+#include <utility>
+#include "go_graph.hpp"
+
+GoGraph::GoGraph(const TermTableView &table)
+{
+    const std::size_t n = table.size();
+    ids_.reserve(n);
+    obsolete_.reserve(n);
+    std::uint32_t max_number = 0;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        ids_.push_back(table.id(i));
+        obsolete_.push_back(table.is_obsolete(i));
+        if (table.id(i).valid())
+            max_number = std::max(max_number, table.id(i).number());
+        for (const auto alt : table.alt_id.row(i))
+            max_number = std::max(max_number, alt.number());
+    }
+
+    // Alt IDs first, so a primary ID always wins over a stale alt_id.
+    index_.assign(n == 0 ? 0 : std::size_t{max_number} + 1, kNoNode);
+    for (std::size_t i = 0; i < n; ++i)
+        for (const auto alt : table.alt_id.row(i))
+            index_[alt.number()] = static_cast<std::uint32_t>(i);
+    for (std::size_t i = 0; i < n; ++i)
+        if (ids_[i].valid())
+            index_[ids_[i].number()] = static_cast<std::uint32_t>(i);
+
+    parents_.offsets.reserve(n + 1);
+    parents_.offsets.push_back(0);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        auto add = [&](const CsrView &csr, Relation rel)
+        {
+            for (const auto target : csr.row(i))
+            {
+                const auto p = node(target);
+                if (p == kNoNode)
+                    continue;
+                parents_.targets.push_back(p);
+                parents_.relation.push_back(rel);
+            }
+        };
+        add(table.is_a, kIsA);
+        add(table.part_of, kPartOf);
+        parents_.offsets.push_back(static_cast<std::uint32_t>(parents_.targets.size()));
+    }
+
+    // Children are the transpose: count, prefix-sum, then scatter.
+    children_.offsets.assign(n + 1, 0);
+    for (const auto p : parents_.targets)
+        ++children_.offsets[p + 1];
+    for (std::size_t i = 0; i < n; ++i)
+        children_.offsets[i + 1] += children_.offsets[i];
+    children_.targets.resize(parents_.targets.size());
+    children_.relation.resize(parents_.targets.size());
+    std::vector<std::uint32_t> fill(children_.offsets.begin(), children_.offsets.begin() + n);
+    for (std::uint32_t c = 0; c < n; ++c)
+    {
+        const auto ps = parents(c);
+        const auto rs = parent_relations(c);
+        for (std::size_t k = 0; k < ps.size(); ++k)
+        {
+            const auto slot = fill[ps[k]]++;
+            children_.targets[slot] = c;
+            children_.relation[slot] = rs[k];
+        }
+    }
+
+    compute_depths();
+    compute_live_ancestors();
+}
+
+// Kahn's order from the roots down; a node's depth is final once all of
+// its parents have been popped.
+void GoGraph::compute_depths()
+{
+    const std::size_t n = size();
+    depth_.assign(n, 0);
+    std::vector<std::uint32_t> pending(n), queue;
+    queue.reserve(n);
+    for (std::uint32_t v = 0; v < n; ++v)
+    {
+        pending[v] = static_cast<std::uint32_t>(parents(v).size());
+        if (pending[v] == 0)
+            queue.push_back(v);
+    }
+    for (std::size_t head = 0; head < queue.size(); ++head)
+    {
+        const auto v = queue[head];
+        for (const auto c : children(v))
+        {
+            depth_[c] = std::max(depth_[c], depth_[v] + 1);
+            if (--pending[c] == 0)
+                queue.push_back(c);
+        }
+    }
+}
+
+// Breadth-first over parent edges from each obsolete node. Obsolete terms
+// are a few percent of a release and sit close to live ones, so this is cheap.
+void GoGraph::compute_live_ancestors()
+{
+    const std::size_t n = size();
+    live_.assign(n, kNoNode);
+    std::vector<std::uint32_t> seen(n, kNoNode), queue;
+    for (std::uint32_t v = 0; v < n; ++v)
+    {
+        if (!obsolete_[v])
+        {
+            live_[v] = v;
+            continue;
+        }
+        queue.assign(1, v);
+        seen[v] = v;
+        for (std::size_t head = 0; head < queue.size() && live_[v] == kNoNode; ++head)
+        {
+            for (const auto p : parents(queue[head]))
+            {
+                if (seen[p] == v)
+                    continue;
+                if (!obsolete_[p])
+                {
+                    live_[v] = p;
+                    break;
+                }
+                seen[p] = v;
+                queue.push_back(p);
+            }
+        }
+    }
+}
+
+std::shared_ptr<const NodeSet> GoGraph::ancestors(std::uint32_t n, unsigned relations) const
+{
+    return closure(parents_, ancestor_cache_, n, relations);
+}
+
+std::shared_ptr<const NodeSet> GoGraph::descendants(std::uint32_t n, unsigned relations) const
+{
+    return closure(children_, descendant_cache_, n, relations);
+}
+
+// Depth-first walk over matching edges that merges, instead of re-walking,
+// every neighbour whose closure is already cached.
+std::shared_ptr<const NodeSet> GoGraph::closure(const Csr &edges, ClosureCache *cache, std::uint32_t n, unsigned relations) const
+{
+    relations &= kAnyRelation;
+    if (relations == 0)
+        relations = kAnyRelation;
+    auto &slot = cache[relations - 1];
+
+    // Readers only: a hit, or a walk that reads the cached closures.
+    auto set = std::make_shared<NodeSet>(size());
+    {
+        std::shared_lock lock(cache_mutex_);
+        const bool cached = !slot.empty();
+        if (cached && slot[n])
+            return slot[n];
+        std::vector<std::uint32_t> stack{n};
+        while (!stack.empty())
+        {
+            const auto v = stack.back();
+            stack.pop_back();
+            const auto nodes = edges.nodes(v);
+            const auto rels = edges.relations(v);
+            for (std::size_t k = 0; k < nodes.size(); ++k)
+            {
+                const auto w = nodes[k];
+                if (!(rels[k] & relations) || set->test(w))
+                    continue;
+                set->set(w);
+                if (cached && slot[w])
+                    set->merge(*slot[w]);
+                else
+                    stack.push_back(w);
+            }
+        }
+    }
+
+    // Another thread may have stored the same closure meanwhile; keep the first.
+    std::unique_lock lock(cache_mutex_);
+    if (slot.empty())
+        slot.resize(size());
+    if (slot[n])
+        return slot[n];
+    if (cached_bytes_ + set->bytes() <= kClosureCacheBytes)
+    {
+        cached_bytes_ += set->bytes();
+        slot[n] = set;
+    }
+    return set;
+}
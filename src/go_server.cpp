@@ -0,0 +1,543 @@
+// go_server.cpp — request handling + Unix socket accept loop and worker pool
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "go_server.hpp"
+#include "task_utils.hpp"
+#include "worker_pool.hpp"
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    volatile std::sig_atomic_t g_stop = 0;
+
+    void on_stop_signal(int)
+    {
+        g_stop = 1;
+    }
+
+    constexpr int kPollMs = 250; // how quickly idle loops notice a stop signal
+
+    void write_ids(std::ostream &out, std::span<const GoId> ids)
+    {
+        for (std::size_t i = 0; i < ids.size(); ++i)
+        {
+            if (i)
+                out << ',';
+            out << ids[i];
+        }
+    }
+
+    std::string_view next_token(std::string_view &rest)
+    {
+        const auto start = rest.find_first_not_of(" \t");
+        if (start == std::string_view::npos)
+        {
+            rest = {};
+            return {};
+        }
+        rest.remove_prefix(start);
+        const auto end = std::min(rest.find_first_of(" \t"), rest.size());
+        const auto token = rest.substr(0, end);
+        rest.remove_prefix(end);
+        return token;
+    }
+
+    struct Filters
+    {
+        std::unordered_set<std::string> namespaces;
+        std::optional<NameFilter> pattern;
+    };
+
+    // namespace=... and pattern=... (the rest of the line); throws on anything else.
+    Filters parse_filters(std::string_view rest)
+    {
+        Filters f;
+        for (auto token = next_token(rest); !token.empty(); token = next_token(rest))
+        {
+            if (token.starts_with("namespace="))
+            {
+                normalize_and_validate_namespaces(split_csv(token.substr(10)), f.namespaces);
+                if (f.namespaces.empty())
+                    throw std::runtime_error("unknown namespace in " + std::string(token));
+            }
+            else if (token.starts_with("pattern="))
+            {
+                const auto regex = std::string(token.substr(8)) + std::string(rest);
+                f.pattern.emplace(regex);
+                break;
+            }
+            else
+                throw std::runtime_error("unexpected argument " + std::string(token));
+        }
+        return f;
+    }
+
+    // relation=is_a, relation=part_of or relation=is_a,part_of; nothing => both
+    unsigned parse_relations(std::string_view rest)
+    {
+        const auto token = next_token(rest);
+        if (token.empty())
+            return GoGraph::kAnyRelation;
+        if (!token.starts_with("relation=") || !next_token(rest).empty())
+            throw std::runtime_error("unexpected argument " + std::string(token));
+        unsigned relations = 0;
+        for (const auto &r : split_csv(token.substr(9)))
+        {
+            if (r == "is_a")
+                relations |= GoGraph::kIsA;
+            else if (r == "part_of")
+                relations |= GoGraph::kPartOf;
+            else
+                throw std::runtime_error("unknown relation " + r);
+        }
+        return relations;
+    }
+
+    bool send_all(int fd, std::string_view data)
+    {
+        while (!data.empty())
+        {
+            const auto n = ::send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+            if (n < 0 && errno == EINTR)
+                continue;
+            if (n <= 0)
+                return false;
+            data.remove_prefix(static_cast<std::size_t>(n));
+        }
+        return true;
+    }
+} // namespace
+
+GoServer::Snapshot::Snapshot(const std::vector<std::string> &obo_files, unsigned threads, bool use_cache)
+    : tables(load_term_tables(obo_files, threads, use_cache)), resolver(tables.views)
+{
+    for (const auto &t : tables.views)
+        graphs.push_back(std::make_unique<const GoGraph>(t));
+
+    std::uint32_t max_number = 0;
+    for (const auto &t : tables.views)
+        for (std::size_t i = 0; i < t.size(); ++i)
+        {
+            if (t.id(i).valid())
+                max_number = std::max(max_number, t.id(i).number());
+            for (const auto alt : t.alt_id.row(i))
+                max_number = std::max(max_number, alt.number());
+        }
+    index.resize(std::size_t{max_number} + 1);
+
+    // Primary IDs first, so an alt_id never shadows a term of its own.
+    for (std::uint32_t k = 0; k < tables.views.size(); ++k)
+        for (std::uint32_t i = 0; i < tables.views[k].size(); ++i)
+            if (const auto id = tables.views[k].id(i); id.valid() && !find(id))
+                index[id.number()] = {k, i};
+    for (std::uint32_t k = 0; k < tables.views.size(); ++k)
+        for (std::uint32_t i = 0; i < tables.views[k].size(); ++i)
+            for (const auto alt : tables.views[k].alt_id.row(i))
+                if (!find(alt))
+                    index[alt.number()] = {k, i};
+}
+
+GoServer::GoServer(const std::vector<std::string> &obo_files, unsigned threads, bool use_cache)
+    : obo_files_(obo_files), threads_(threads), use_cache_(use_cache),
+      snapshot_(std::make_shared<const Snapshot>(obo_files, threads, use_cache))
+{
+}
+
+void GoServer::reload()
+{
+    snapshot_.store(std::make_shared<const Snapshot>(obo_files_, threads_, use_cache_));
+}
+
+bool GoServer::handle(std::string_view request, std::string &reply) const
+{
+    if (!request.empty() && request.back() == '\r')
+        request.remove_suffix(1);
+    auto rest = request;
+    const auto command = next_token(rest);
+    const auto snap = snapshot_.load(); // pinned until this request is answered
+
+    std::ostringstream body;
+    std::size_t lines = 0;
+    try
+    {
+        if (command == "QUIT")
+            return false;
+        if (command == "PING")
+        {
+        }
+        else if (command == "LOOKUP" || command == "RESOLVE" || command == "ANCESTORS" || command == "DESCENDANTS")
+        {
+            const auto token = next_token(rest);
+            const auto id = GoId::parse(token);
+            if (!id.valid())
+                throw std::runtime_error("expected a GO ID, got '" + std::string(token) + "'");
+            if (command == "RESOLVE")
+            {
+                std::string row;
+                {
+                    TabWriter out(row);
+                    write_resolution_row(out, id, snap->resolver.status(id), snap->resolver.targets(id));
+                }
+                body << row;
+                lines = 1;
+            }
+            else if (command != "LOOKUP")
+            {
+                const unsigned relations = parse_relations(rest);
+                if (const auto *r = snap->find(id))
+                {
+                    const auto &g = *snap->graphs[r->table];
+                    const auto n = g.node(id);
+                    const auto set = command == "ANCESTORS" ? g.ancestors(n, relations) : g.descendants(n, relations);
+                    std::vector<std::uint32_t> nodes;
+                    nodes.reserve(set->count());
+                    set->for_each([&nodes](std::uint32_t v)
+                                  { nodes.push_back(v); });
+                    std::sort(nodes.begin(), nodes.end(), [&g](std::uint32_t a, std::uint32_t b)
+                              { return g.id(a) < g.id(b); });
+                    std::string rows;
+                    {
+                        TabWriter out(rows);
+                        for (const auto v : nodes)
+                            out.cell(g.id(v)).cell(std::uint64_t{g.depth(v)}).end_row();
+                    }
+                    body << rows;
+                    lines = nodes.size();
+                }
+            }
+            else if (const auto *r = snap->find(id))
+            {
+                const auto &t = snap->tables.views[r->table];
+                body << t.id(r->row) << '\t' << t.name(r->row) << '\t' << t.ns(r->row) << '\t'
+                     << (t.is_obsolete(r->row) ? "obsolete" : "live") << "\treplaced_by=";
+                write_ids(body, t.replaced_by.row(r->row));
+                body << ";consider=";
+                write_ids(body, t.consider.row(r->row));
+                body << '\n';
+                lines = 1;
+            }
+        }
+        else if (command == "CONSIDER" || command == "STATS")
+        {
+            const auto filters = parse_filters(rest);
+            const NameFilter *pat = filters.pattern ? &*filters.pattern : nullptr;
+            // One thread per request: concurrency comes from the connection workers.
+            const auto scan = scan_term_tables(snap->tables.views, filters.namespaces, pat,
+                                               command == "CONSIDER" ? kConsiderRows : kObsoleteStats, 1);
+            std::string rows;
+            {
+                TabWriter out(rows);
+                for (const auto &row : scan.consider_rows)
+                    write_consider_row(out, row);
+                lines = scan.consider_rows.size();
+                if (command == "STATS")
+                {
+                    write_stats_header(out);
+                    write_stats_rows(out, scan.obsolete_stats);
+                    lines = scan.obsolete_stats.size() + 1;
+                }
+            }
+            body << rows;
+        }
+        else
+            throw std::runtime_error("unknown request '" + std::string(command) + "'");
+    }
+    catch (const std::exception &e)
+    {
+        reply += "ERR ";
+        reply += e.what();
+        reply += '\n';
+        return true;
+    }
+    reply += "OK " + std::to_string(lines) + '\n';
+    reply += body.str();
+    return true;
+}
+
+// Watches each input's directory rather than the file, so releases that
+// are replaced by rename (or deleted and rewritten) are still seen.
+void GoServer::watch_inputs(int inotify_fd)
+{
+    std::map<int, std::vector<std::string>> names; // watch descriptor -> input file names
+    for (const auto &f : obo_files_)
+    {
+        const fs::path path(f);
+        const auto dir = path.has_parent_path() ? path.parent_path() : fs::path(".");
+        const int wd = ::inotify_add_watch(inotify_fd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+        if (wd < 0)
+        {
+            std::cerr << "Warning: cannot watch " << dir.string() << ": " << std::strerror(errno) << "\n";
+            continue;
+        }
+        names[wd].push_back(path.filename().string());
+    }
+
+    alignas(inotify_event) char buf[4096];
+    bool changed = false;
+    auto last_change = std::chrono::steady_clock::now();
+    while (!g_stop)
+    {
+        pollfd p{inotify_fd, POLLIN, 0};
+        if (::poll(&p, 1, kPollMs) > 0)
+        {
+            for (ssize_t n; (n = ::read(inotify_fd, buf, sizeof buf)) > 0;)
+            {
+                for (const char *at = buf; at < buf + n;)
+                {
+                    const auto *ev = reinterpret_cast<const inotify_event *>(at);
+                    at += sizeof(inotify_event) + ev->len;
+                    const auto it = names.find(ev->wd);
+                    if (ev->len == 0 || it == names.end())
+                        continue;
+                    if (std::find(it->second.begin(), it->second.end(), std::string_view(ev->name)) != it->second.end())
+                    {
+                        changed = true;
+                        last_change = std::chrono::steady_clock::now();
+                    }
+                }
+            }
+        }
+
+        // Writers often touch a file several times; wait until it settles.
+        if (!changed || std::chrono::steady_clock::now() - last_change < std::chrono::milliseconds(kReloadQuietMs))
+            continue;
+        changed = false;
+        try
+        {
+            reload();
+            std::cerr << "Reloaded " << obo_files_.size() << " release(s)\n";
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "Warning: reload failed, still serving the previous snapshot: " << e.what() << "\n";
+        }
+    }
+}
+
+void GoServer::serve(const std::string &socket_path, unsigned workers)
+{
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (socket_path.empty() || socket_path.size() >= sizeof addr.sun_path)
+        throw std::runtime_error("socket path must be 1-" + std::to_string(sizeof addr.sun_path - 1) + " bytes: " + socket_path);
+    std::memcpy(addr.sun_path, socket_path.c_str(), socket_path.size() + 1);
+
+    struct stat st{};
+    if (::lstat(socket_path.c_str(), &st) == 0)
+    {
+        if (!S_ISSOCK(st.st_mode))
+            throw std::runtime_error("refusing to replace non-socket " + socket_path);
+        ::unlink(socket_path.c_str());
+    }
+
+    const int listener = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listener < 0)
+        throw std::runtime_error(std::string("socket: ") + std::strerror(errno));
+    if (::bind(listener, reinterpret_cast<const sockaddr *>(&addr), sizeof addr) != 0 || ::listen(listener, SOMAXCONN) != 0)
+    {
+        const std::string err = std::strerror(errno);
+        ::close(listener);
+        throw std::runtime_error("cannot listen on " + socket_path + ": " + err);
+    }
+    const int wake = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC); // workers -> poll loop: a batch was answered
+    if (wake < 0)
+    {
+        const std::string err = std::strerror(errno);
+        ::close(listener);
+        throw std::runtime_error("eventfd: " + err);
+    }
+
+    struct sigaction sa{};
+    sa.sa_handler = on_stop_signal; // no SA_RESTART: poll() returns EINTR
+    sigemptyset(&sa.sa_mask);
+    ::sigaction(SIGINT, &sa, nullptr);
+    ::sigaction(SIGTERM, &sa, nullptr);
+
+    std::thread watcher;
+    const int inotify_fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_fd >= 0)
+        watcher = std::thread([this, inotify_fd]
+                              { watch_inputs(inotify_fd); });
+    else
+        std::cerr << "Warning: inotify unavailable, inputs will not be reloaded: " << std::strerror(errno) << "\n";
+
+    // Connections are polled here; a worker is taken only while it answers
+    // a batch of complete request lines, so an idle client costs an fd, not
+    // a thread. At most one batch per connection is in flight, which keeps
+    // its replies in request order.
+    struct Connection
+    {
+        std::string in;    // bytes after the last dispatched line
+        bool busy = false; // a worker is answering a batch
+    };
+    struct Batch
+    {
+        int fd;
+        std::string lines; // newline-terminated
+    };
+    std::map<int, Connection> connections;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<Batch> batches;              // waiting for a worker
+    std::vector<std::pair<int, bool>> done; // answered batches: fd, still open
+
+    // Queues every complete line; false once a line is over kMaxRequestBytes.
+    auto dispatch = [&](int fd, Connection &c)
+    {
+        std::size_t end = 0;
+        for (std::size_t nl; (nl = c.in.find('\n', end)) != std::string::npos; end = nl + 1)
+            if (nl - end > kMaxRequestBytes)
+                return false;
+        if (c.in.size() - end > kMaxRequestBytes)
+            return false;
+        if (end > 0)
+        {
+            {
+                std::lock_guard lock(mutex);
+                batches.push_back({fd, c.in.substr(0, end)});
+            }
+            c.in.erase(0, end);
+            c.busy = true;
+            cv.notify_one();
+        }
+        return true;
+    };
+
+    std::vector<std::thread> pool;
+    const unsigned n = resolve_thread_count(workers);
+    pool.reserve(n);
+    for (unsigned w = 0; w < n; ++w)
+        pool.emplace_back([&]
+                          {
+                              std::string reply;
+                              for (;;)
+                              {
+                                  Batch b;
+                                  {
+                                      std::unique_lock lock(mutex);
+                                      cv.wait(lock, [&]
+                                              { return g_stop || !batches.empty(); });
+                                      if (batches.empty())
+                                          return;
+                                      b = std::move(batches.front());
+                                      batches.pop_front();
+                                  }
+                                  reply.clear();
+                                  bool open = true;
+                                  for (std::string_view rest = b.lines; open && !rest.empty();)
+                                  {
+                                      const auto nl = rest.find('\n');
+                                      open = handle(rest.substr(0, nl), reply);
+                                      rest.remove_prefix(nl + 1);
+                                  }
+                                  open = send_all(b.fd, reply) && open;
+                                  {
+                                      std::lock_guard lock(mutex);
+                                      done.emplace_back(b.fd, open);
+                                  }
+                                  const std::uint64_t one = 1;
+                                  (void)!::write(wake, &one, sizeof one);
+                              } });
+
+    std::vector<pollfd> fds;
+    std::vector<std::pair<int, bool>> answered;
+    char buf[64 * 1024];
+    while (!g_stop)
+    {
+        fds.assign({{listener, POLLIN, 0}, {wake, POLLIN, 0}});
+        for (const auto &[fd, c] : connections)
+            if (!c.busy)
+                fds.push_back({fd, POLLIN, 0});
+        if (::poll(fds.data(), fds.size(), kPollMs) <= 0)
+            continue;
+
+        if (fds[1].revents & POLLIN)
+        {
+            std::uint64_t count;
+            (void)!::read(wake, &count, sizeof count);
+            {
+                std::lock_guard lock(mutex);
+                answered.swap(done);
+            }
+            for (const auto &[fd, open] : answered)
+            {
+                connections[fd].busy = false;
+                if (!open)
+                {
+                    ::close(fd);
+                    connections.erase(fd);
+                }
+            }
+            answered.clear();
+        }
+
+        for (std::size_t k = 2; k < fds.size(); ++k)
+        {
+            if (!fds[k].revents)
+                continue;
+            const int fd = fds[k].fd;
+            const auto got = ::recv(fd, buf, sizeof buf, 0);
+            if (got < 0 && errno == EINTR)
+                continue;
+            auto &c = connections[fd];
+            if (got > 0)
+            {
+                c.in.append(buf, static_cast<std::size_t>(got));
+                if (dispatch(fd, c))
+                    continue;
+                send_all(fd, "ERR request line longer than " + std::to_string(kMaxRequestBytes) + " bytes\n");
+            }
+            ::close(fd);
+            connections.erase(fd);
+        }
+
+        if (fds[0].revents & POLLIN)
+        {
+            const int fd = ::accept4(listener, nullptr, nullptr, SOCK_CLOEXEC);
+            if (fd >= 0)
+            {
+                // A client that stops reading frees its worker after this long
+                const timeval timeout{kSendTimeoutMs / 1000, kSendTimeoutMs % 1000 * 1000};
+                ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof timeout);
+                connections.emplace(fd, Connection{});
+            }
+        }
+    }
+
+    {
+        std::lock_guard lock(mutex); // g_stop is already set; wake idle workers
+    }
+    cv.notify_all();
+    for (auto &t : pool)
+        t.join();
+    if (watcher.joinable())
+        watcher.join();
+    if (inotify_fd >= 0)
+        ::close(inotify_fd);
+    for (const auto &[fd, c] : connections)
+        ::close(fd);
+    ::close(wake);
+    ::close(listener);
+    ::unlink(socket_path.c_str());
+}
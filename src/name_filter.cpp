@@ -0,0 +1,126 @@
+// name_filter.cpp — literal extraction + prefiltered regex matching
+#include <algorithm>
+#include <cstring>
+#include "name_filter.hpp"
+#include "simd_scan.hpp"
+
+// Escapes that stand for the character itself.
+static bool is_literal_escape(char c)
+{
+    return std::strchr(".^$|()[]{}*+?\\/-", c) != nullptr;
+}
+
+std::vector<std::string> required_literals(std::string_view pattern)
+{
+    std::vector<std::string> out;
+    std::string run;
+    auto flush = [&]
+    {
+        if (!run.empty())
+            out.push_back(std::move(run));
+        run.clear();
+    };
+
+    for (std::size_t i = 0; i < pattern.size(); ++i)
+    {
+        const char c = pattern[i];
+        switch (c)
+        {
+        case '|':
+            return {}; // top-level alternation: nothing is required
+        case '*':
+        case '?':
+        case '{':
+            // The previous atom may occur zero times.
+            if (!run.empty())
+                run.pop_back();
+            flush();
+            if (c == '{')
+                while (i < pattern.size() && pattern[i] != '}')
+                    ++i;
+            break;
+        case '+':
+            flush(); // the atom is required, but not what follows it
+            break;
+        case '(':
+        case '[':
+        {
+            // Skip the whole group or class; its content is not required.
+            flush();
+            const char open = c, close = c == '(' ? ')' : ']';
+            int depth = 0;
+            for (; i < pattern.size(); ++i)
+            {
+                if (pattern[i] == '\\')
+                    ++i;
+                else if (pattern[i] == open && open == '(')
+                    ++depth;
+                else if (pattern[i] == close && (open == '[' || --depth == 0))
+                    break;
+            }
+            break;
+        }
+        case '\\':
+        {
+            if (i + 1 >= pattern.size())
+                break;
+            const char e = pattern[++i];
+            if (is_literal_escape(e))
+            {
+                run.push_back(e);
+                break;
+            }
+            // \d, \b, \n, \x64, \u0041, \cJ, \12, ...: a class, an assertion or a
+            // coded character. Skip its operand too, so hex or control digits
+            // and backreference numbers are not taken as literals.
+            flush();
+            std::size_t operand = 0;
+            if (e == 'x')
+                operand = 2;
+            else if (e == 'u')
+                operand = 4;
+            else if (e == 'c')
+                operand = 1;
+            else if (e >= '0' && e <= '9')
+                while (i + 1 + operand < pattern.size() && pattern[i + 1 + operand] >= '0' && pattern[i + 1 + operand] <= '9')
+                    ++operand;
+            i = std::min(i + operand, pattern.size() - 1);
+            break;
+        }
+        case '.':
+        case '^':
+        case '$':
+        case ')':
+        case ']':
+        case '}':
+            flush();
+            break;
+        default:
+            run.push_back(c);
+            break;
+        }
+    }
+    flush();
+
+    std::stable_sort(out.begin(), out.end(), [](const std::string &a, const std::string &b)
+                     { return a.size() > b.size(); });
+    return out;
+}
+
+NameFilter::NameFilter(const std::string &pattern, std::regex::flag_type flags)
+    : pattern_(pattern), re_(pattern, flags)
+{
+    // Case-insensitive or non-ECMAScript grammars would need a different extractor.
+    const auto other_grammars = std::regex::basic | std::regex::extended | std::regex::awk |
+                                std::regex::grep | std::regex::egrep;
+    if (!(flags & std::regex::icase) && !(flags & other_grammars))
+        literals_ = required_literals(pattern);
+}
+
+bool NameFilter::matches(std::string_view name) const
+{
+    for (const auto &lit : literals_)
+        if (!simd_scan::contains(name, lit))
+            return false;
+    return std::regex_search(name.begin(), name.end(), re_);
+}
@@ -0,0 +1,380 @@
+// obo_engine.cpp — fused consider-table / obsolete-stats pass over OBO chunks
+#include <algorithm>
+#include <deque>
+#include <iterator>
+#include <string_view>
+#include "bgzf.hpp"
+#include "decompress.hpp"
+#include "go_namespace.hpp"
+#include "obo_engine.hpp"
+#include "obo_scanner.hpp"
+#include "term_table.hpp"
+#include "task_utils.hpp"
+#include "worker_pool.hpp"
+
+static void add_consider_row(std::vector<ConsiderRow> &out, const OboTerm &t)
+{
+    ConsiderRow row;
+    row.obsolete_id = t.id;
+    row.alternatives.reserve(t.consider.size() + t.replaced_by.size());
+    row.alternatives.insert(row.alternatives.end(), t.consider.begin(), t.consider.end());
+    row.alternatives.insert(row.alternatives.end(), t.replaced_by.begin(), t.replaced_by.end());
+    if (!t.is_a.empty())
+        row.parent_id = t.is_a.front();
+    else if (!t.part_of.empty())
+        row.parent_id = t.part_of.front();
+    out.push_back(std::move(row));
+}
+
+namespace
+{
+    // Obsolete-term counters for one job: a dense slot per GO namespace plus
+    // "all", with other namespace values (rare) kept by name. Each job owns
+    // one block and blocks are cache-line aligned, so workers never write to
+    // a shared line; the blocks are summed once the workers have joined and
+    // only then turned into the name-keyed map.
+    struct alignas(64) StatsBlock
+    {
+        NamespaceStats all;
+        NamespaceStats by_ns[kGoNamespaces];
+        std::vector<std::pair<std::string, NamespaceStats>> other;
+
+        void add(const OboTerm &t)
+        {
+            NamespaceStats delta;
+            delta.obsolete_total = 1;
+            if (!t.replaced_by.empty())
+                delta.with_replaced_by = delta.with_alternatives = 1;
+            else if (!t.consider.empty())
+                delta.consider_only = delta.with_alternatives = 1;
+            else
+                delta.no_alternative = 1;
+
+            all += delta;
+            if (t.ns.empty())
+                return;
+            const auto k = classify_namespace(t.ns);
+            if (k != GoNamespace::kOther)
+            {
+                by_ns[static_cast<std::size_t>(k)] += delta;
+                return;
+            }
+            for (auto &[name, st] : other)
+                if (name == t.ns)
+                {
+                    st += delta;
+                    return;
+                }
+            other.emplace_back(std::string(t.ns), delta);
+        }
+
+        StatsBlock &operator+=(const StatsBlock &o)
+        {
+            all += o.all;
+            for (std::size_t k = 0; k < kGoNamespaces; ++k)
+                by_ns[k] += o.by_ns[k];
+            for (const auto &[name, st] : o.other)
+            {
+                auto it = std::find_if(other.begin(), other.end(), [&](const auto &e)
+                                       { return e.first == name; });
+                if (it == other.end())
+                    other.emplace_back(name, st);
+                else
+                    it->second += st;
+            }
+            return *this;
+        }
+
+        // "all" is always present; a namespace only once it has counted a term.
+        std::map<std::string, NamespaceStats> to_map() const
+        {
+            std::map<std::string, NamespaceStats> m;
+            m["all"] = all;
+            for (std::size_t k = 0; k < kGoNamespaces; ++k)
+                if (by_ns[k].obsolete_total)
+                    m[std::string(kGoNamespaceNames[k])] += by_ns[k];
+            for (const auto &[name, st] : other)
+                m[name] += st;
+            return m;
+        }
+    };
+
+    // What one job produces; merged in job order.
+    struct JobOutput
+    {
+        std::vector<ConsiderRow> consider_rows;
+        StatsBlock stats;
+    };
+} // namespace
+
+// Everything the filters and both outputs read; alt_id and xref are skipped.
+static constexpr unsigned kEngineFields =
+    obo_field::kId | obo_field::kName | obo_field::kNamespace | obo_field::kIsObsolete |
+    obo_field::kConsider | obo_field::kReplacedBy | obo_field::kIsA | obo_field::kRelationship;
+
+namespace
+{
+    // Filters one term and feeds it to the requested outputs.
+    struct TermSink
+    {
+        const std::unordered_set<std::string> &ns_filter;
+        const NameFilter *name_filter;
+        unsigned outputs;
+        JobOutput out;
+
+        // Cheapest test first; the name is only looked at for obsolete
+        // terms in an allowed namespace.
+        bool wanted(bool is_obsolete, GoId id, std::string_view ns, std::string_view name) const
+        {
+            return is_obsolete && id.valid() && namespace_allowed(ns_filter, ns) &&
+                   (!name_filter || name_filter->matches(name));
+        }
+
+        void operator()(const OboTerm &t)
+        {
+            if (wanted(t.is_obsolete, t.id, t.ns, t.name))
+                add(t);
+        }
+
+        void add(const OboTerm &t)
+        {
+            if (outputs & kConsiderRows)
+                add_consider_row(out.consider_rows, t);
+            if (outputs & kObsoleteStats)
+                out.stats.add(t);
+        }
+    };
+
+    // A unit of text work: a stanza-aligned chunk of a mapped plain or
+    // inflated BGZF file, or a whole compressed file streamed through an
+    // InflateStream.
+    struct TextItem
+    {
+        std::size_t file; // index into the inputs
+        std::string_view chunk;
+        bool stream;
+    };
+
+    struct TextPlan
+    {
+        OboChunkPlan mapped;              // plain inputs only
+        std::deque<std::string> inflated; // BGZF inputs, inflated block-parallel up front
+        std::vector<TextItem> items;      // in input/offset order
+        std::vector<std::size_t> order;   // streams first: they are the longest jobs
+    };
+
+    // With keys (one per path, from stat_cache_key), BGZF .gzi indexes are
+    // used and kept, and every mapped input's content hash is filled in from
+    // the bytes that will be parsed; streamed inputs are hashed by
+    // for_each_item_term. Without keys, no sidecar file is read or written.
+    TextPlan plan_text(const std::vector<std::string> &paths, unsigned threads, std::vector<CacheKey> *keys)
+    {
+        TextPlan plan;
+        enum class Kind { kPlain, kBgzf, kStream };
+        std::vector<Kind> kind(paths.size(), Kind::kPlain);
+        std::vector<std::string> plain;
+        for (std::size_t f = 0; f < paths.size(); ++f)
+        {
+            const auto codec = detect_codec_of(paths[f]);
+            if (codec == Codec::kNone)
+                plain.push_back(paths[f]);
+            else
+                kind[f] = codec == Codec::kGzip && is_bgzf(MappedFile(paths[f]).view()) ? Kind::kBgzf : Kind::kStream;
+        }
+        plan.mapped = plan_obo_chunks(plain, threads);
+
+        std::size_t c = 0, p = 0;
+        std::vector<std::size_t> plain_file; // input index per plan.mapped file
+        for (std::size_t f = 0; f < paths.size(); ++f)
+        {
+            if (kind[f] == Kind::kStream)
+            {
+                plan.items.push_back({f, {}, true});
+                continue;
+            }
+            if (kind[f] == Kind::kBgzf)
+            {
+                // Independent blocks: inflate on every worker, then chunk like a plain file.
+                const BgzfFile bgzf(paths[f], keys != nullptr);
+                if (keys)
+                    (*keys)[f].content_hash = hash_cache_contents(bgzf.compressed());
+                const auto &buf = plan.inflated.emplace_back(bgzf.inflate_all(threads));
+                for (const auto chunk : split_at_stanzas(buf, std::size_t{resolve_thread_count(threads)} * 4))
+                    plan.items.push_back({f, chunk, false});
+                continue;
+            }
+            for (; c < plan.mapped.chunks.size() && plan.mapped.chunk_file[c] == p; ++c)
+                plan.items.push_back({f, plan.mapped.chunks[c], false});
+            plain_file.push_back(f);
+            ++p;
+        }
+        if (keys)
+            parallel_for_index(plain_file.size(), threads, [&](std::size_t i)
+                               { (*keys)[plain_file[i]].content_hash = hash_cache_contents(plan.mapped.files[i].view()); });
+
+        for (std::size_t i = 0; i < plan.items.size(); ++i)
+            if (plan.items[i].stream)
+                plan.order.push_back(i);
+        for (std::size_t i = 0; i < plan.items.size(); ++i)
+            if (!plan.items[i].stream)
+                plan.order.push_back(i);
+        return plan;
+    }
+
+    // With stream_hash, a streamed input's content hash is stored there.
+    template <unsigned Fields, typename Visit>
+    void for_each_item_term(const TextItem &item, const std::vector<std::string> &paths, Visit &&visit,
+                            std::uint64_t *stream_hash = nullptr)
+    {
+        if (item.stream)
+        {
+            InflateStream in(paths[item.file]);
+            if (stream_hash)
+                *stream_hash = hash_cache_contents(in.compressed());
+            for_each_term<Fields>(in, visit);
+        }
+        else
+            for_each_term<Fields>(item.chunk, visit);
+    }
+
+    // Rows [begin, end) of one term table.
+    struct TableRange
+    {
+        const TermTableView *table;
+        std::size_t begin, end;
+    };
+
+    // Table ranges big enough to amortise the hand-off, like kMinChunkBytes for text.
+    constexpr std::size_t kTableRangeTerms = 64 * 1024;
+} // namespace
+
+TermTables load_term_tables(const std::vector<std::string> &obo_files, unsigned threads, bool use_cache)
+{
+    TermTables t;
+    t.caches.resize(obo_files.size());
+    std::vector<std::string> stale;
+    std::vector<std::size_t> stale_index;
+    for (std::size_t f = 0; f < obo_files.size(); ++f)
+    {
+        if (!use_cache || !t.caches[f].open(obo_files[f]))
+        {
+            stale.push_back(obo_files[f]);
+            stale_index.push_back(f);
+        }
+    }
+
+    if (!stale.empty())
+    {
+        // Keyed on the bytes on disk, compressed or not: stat'ed before they
+        // are read and hashed as they are parsed, so a file rewritten
+        // meanwhile just misses next time.
+        std::vector<CacheKey> keys;
+        for (std::size_t k = 0; use_cache && k < stale.size(); ++k)
+            keys.push_back(stat_cache_key(stale[k]));
+        const auto plan = plan_text(stale, threads, use_cache ? &keys : nullptr);
+        std::vector<TermTableBuilder> per_item(plan.items.size());
+        parallel_for_index(plan.items.size(), threads, [&](std::size_t j)
+                           {
+                               const auto i = plan.order[j];
+                               const auto &item = plan.items[i];
+                               for_each_item_term<TermTableBuilder::kFields>(item, stale, [&](const OboTerm &term)
+                                                                             { per_item[i].add(term); },
+                                                                             use_cache ? &keys[item.file].content_hash : nullptr); });
+
+        t.built.resize(stale.size());
+        for (std::size_t i = 0; i < plan.items.size(); ++i)
+            t.built[plan.items[i].file].append(per_item[i]);
+        for (std::size_t k = 0; use_cache && k < stale.size(); ++k)
+            t.built[k].write_cache(cache_path_for(stale[k]), keys[k]); // read-only directory: no cache next time
+    }
+
+    t.views.resize(obo_files.size());
+    for (std::size_t f = 0; f < obo_files.size(); ++f)
+        t.views[f] = t.caches[f].view();
+    for (std::size_t k = 0; k < stale.size(); ++k)
+        t.views[stale_index[k]] = t.built[k].view();
+    return t;
+}
+
+static void merge_into(ScanResult &out, std::vector<JobOutput> &parts, unsigned outputs)
+{
+    if (outputs & kConsiderRows)
+    {
+        std::size_t total = 0;
+        for (const auto &part : parts)
+            total += part.consider_rows.size();
+        out.consider_rows.reserve(total);
+        for (auto &part : parts)
+            std::move(part.consider_rows.begin(), part.consider_rows.end(), std::back_inserter(out.consider_rows));
+    }
+    if (outputs & kObsoleteStats)
+    {
+        StatsBlock total{};
+        for (const auto &part : parts)
+            total += part.stats;
+        out.obsolete_stats = total.to_map();
+    }
+}
+
+ScanResult scan_obo_files(
+    const std::vector<std::string> &obo_files,
+    const std::unordered_set<std::string> &ns_filter,
+    const NameFilter *name_filter,
+    unsigned outputs,
+    unsigned threads,
+    bool use_cache)
+{
+    if (!use_cache)
+    {
+        ScanResult out;
+        const auto plan = plan_text(obo_files, threads, nullptr);
+
+        // One slot per item, filled in any order, merged in file/offset order.
+        std::vector<JobOutput> per_item(plan.items.size());
+        parallel_for_index(plan.items.size(), threads, [&](std::size_t j)
+                           {
+                               const auto i = plan.order[j];
+                               TermSink sink{ns_filter, name_filter, outputs, {}};
+                               for_each_item_term<kEngineFields>(plan.items[i], obo_files, sink);
+                               per_item[i] = std::move(sink.out); });
+        merge_into(out, per_item, outputs);
+        return out;
+    }
+
+    const auto tables = load_term_tables(obo_files, threads, true);
+    return scan_term_tables(tables.views, ns_filter, name_filter, outputs, threads);
+}
+
+ScanResult scan_term_tables(
+    std::span<const TermTableView> views,
+    const std::unordered_set<std::string> &ns_filter,
+    const NameFilter *name_filter,
+    unsigned outputs,
+    unsigned threads)
+{
+    ScanResult out;
+    std::vector<TableRange> ranges;
+    for (const auto &view : views)
+        for (std::size_t b = 0; b < view.size(); b += kTableRangeTerms)
+            ranges.push_back({&view, b, std::min(view.size(), b + kTableRangeTerms)});
+
+    std::vector<JobOutput> per_range(ranges.size());
+    parallel_for_index(ranges.size(), threads, [&](std::size_t i)
+                       {
+                           const auto &r = ranges[i];
+                           TermSink sink{ns_filter, name_filter, outputs, {}};
+                           ScratchArena<kStanzaScratchBytes> arena;
+                           OboTerm term(arena.resource());
+                           for (std::size_t k = r.begin; k < r.end; ++k)
+                           {
+                               // Filter on the columns; rows are only materialised once they pass.
+                               const auto &table = *r.table;
+                               if (!sink.wanted(table.is_obsolete(k), table.id(k), table.ns(k), table.name(k)))
+                                   continue;
+                               table.load(k, term);
+                               sink.add(term);
+                           }
+                           per_range[i] = std::move(sink.out); });
+    merge_into(out, per_range, outputs);
+    return out;
+}
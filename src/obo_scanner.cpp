@@ -0,0 +1,156 @@
+// obo_scanner.cpp — MappedFile (POSIX mmap) + stanza-aligned chunking
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+#include "obo_scanner.hpp"
+#include "simd_scan.hpp"
+#include "worker_pool.hpp"
+
+// Chunks smaller than this cost more in thread hand-off than they save.
+static constexpr std::size_t kMinChunkBytes = std::size_t{4} << 20;
+
+MappedFile::MappedFile(const std::string &path)
+{
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("cannot open file: " + path);
+
+    struct stat st{};
+    if (::fstat(fd, &st) != 0)
+    {
+        ::close(fd);
+        throw std::runtime_error("cannot stat file: " + path);
+    }
+    size_ = static_cast<std::size_t>(st.st_size);
+    if (size_ > 0)
+    {
+        void *p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED)
+        {
+            ::close(fd);
+            throw std::runtime_error("cannot mmap file: " + path);
+        }
+        ::madvise(p, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<const char *>(p);
+    }
+    ::close(fd); // the mapping keeps its own reference
+}
+
+MappedFile::~MappedFile()
+{
+    if (data_)
+        ::munmap(const_cast<char *>(data_), size_);
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+    : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0))
+{
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept
+{
+    if (this != &other)
+    {
+        if (data_)
+            ::munmap(const_cast<char *>(data_), size_);
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+}
+
+bool replace_file(const std::string &path, std::span<const std::string_view> parts)
+{
+    std::string tmp = path + ".XXXXXX";
+    const int fd = ::mkstemp(tmp.data());
+    if (fd < 0)
+        return false; // read-only directory: the caller rebuilds next time
+    bool ok = ::fchmod(fd, 0644) == 0;
+    for (auto part : parts)
+        while (ok && !part.empty())
+        {
+            const ssize_t n = ::write(fd, part.data(), part.size());
+            if (n < 0 && errno == EINTR)
+                continue;
+            ok = n > 0;
+            if (ok)
+                part.remove_prefix(static_cast<std::size_t>(n));
+        }
+    ok = ::close(fd) == 0 && ok;
+    ok = ok && std::rename(tmp.c_str(), path.c_str()) == 0;
+    if (!ok)
+        std::remove(tmp.c_str());
+    return ok;
+}
+
+// First stanza header at or after `from`; returns buf.size() if there is none.
+static std::size_t next_stanza_start(std::string_view buf, std::size_t from)
+{
+    if (from == 0 || from >= buf.size())
+        return std::min(from, buf.size());
+    for (std::size_t pos = simd_scan::find_line_bracket(buf, from); pos != std::string_view::npos;
+         pos = simd_scan::find_line_bracket(buf, pos + 1))
+    {
+        const auto header = buf.substr(pos, 10);
+        if (header.starts_with("[Term]") || header.starts_with("[Typedef]") || header.starts_with("[Instance]"))
+            return pos;
+    }
+    return buf.size();
+}
+
+std::vector<std::string_view> split_at_stanzas(std::string_view buf, std::size_t parts)
+{
+    std::vector<std::string_view> out;
+    if (parts <= 1 || buf.size() < 2 * kMinChunkBytes)
+    {
+        out.push_back(buf);
+        return out;
+    }
+    parts = std::min(parts, buf.size() / kMinChunkBytes);
+
+    std::size_t begin = 0;
+    for (std::size_t k = 1; k <= parts && begin < buf.size(); ++k)
+    {
+        const std::size_t end = (k == parts) ? buf.size() : next_stanza_start(buf, buf.size() / parts * k);
+        if (end > begin)
+        {
+            out.push_back(buf.substr(begin, end - begin));
+            begin = end;
+        }
+    }
+    return out;
+}
+
+OboChunkPlan plan_obo_chunks(const std::vector<std::string> &paths, unsigned threads)
+{
+    OboChunkPlan plan;
+    plan.files.reserve(paths.size());
+    std::size_t total = 0;
+    for (const auto &p : paths)
+    {
+        plan.files.emplace_back(p);
+        total += plan.files.back().view().size();
+    }
+
+    // A few chunks per worker evens out files of different sizes.
+    const unsigned workers = resolve_thread_count(threads);
+    const std::size_t target = workers <= 1 ? 0 : std::max(kMinChunkBytes, total / (std::size_t{workers} * 4));
+
+    for (std::size_t f = 0; f < plan.files.size(); ++f)
+    {
+        const auto buf = plan.files[f].view();
+        const std::size_t parts = target == 0 ? 1 : (buf.size() + target - 1) / target;
+        for (const auto chunk : split_at_stanzas(buf, parts))
+        {
+            plan.chunks.push_back(chunk);
+            plan.chunk_file.push_back(f);
+        }
+    }
+    return plan;
+}
@@ -0,0 +1,282 @@
+// packed_seq.cpp — PackedSeq encoding choice, word-at-a-time unpack and packed-code search
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include "packed_seq.hpp"
+
+namespace
+{
+    using Codes = std::array<std::int8_t, 256>; // byte -> code, -1 = exception
+
+    constexpr Codes make_codes(std::string_view letters)
+    {
+        Codes t{};
+        t.fill(-1);
+        for (std::size_t k = 0; k < letters.size(); ++k)
+        {
+            const auto c = static_cast<unsigned char>(letters[k]);
+            t[c] = static_cast<std::int8_t>(k);
+            if (c >= 'A' && c <= 'Z')
+                t[c | 0x20] = static_cast<std::int8_t>(k); // lowercase goes to the mask list
+        }
+        return t;
+    }
+
+    constexpr std::string_view kDnaLetters = "ACGT";
+    constexpr std::string_view kProteinLetters = "ABCDEFGHIJKLMNOPQRSTUVWXYZ*-";
+    constexpr Codes kDnaCodes = make_codes(kDnaLetters);
+    constexpr Codes kProteinCodes = make_codes(kProteinLetters);
+
+    // The four bases held in one byte of a 2-bit word, lowest bits first
+    constexpr auto kDnaQuads = []
+    {
+        std::array<std::array<char, 4>, 256> t{};
+        for (unsigned b = 0; b < 256; ++b)
+            for (unsigned j = 0; j < 4; ++j)
+                t[b][j] = kDnaLetters[(b >> (2 * j)) & 3];
+        return t;
+    }();
+
+    constexpr bool is_lower(unsigned char c) { return static_cast<unsigned>(c - 'a') < 26; }
+
+    std::size_t words_for(std::size_t n, unsigned per) { return (n + per - 1) / per; }
+
+    std::uint64_t low_bits(unsigned n) { return n >= 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << n) - 1; }
+}
+
+PackedSeq PackedSeq::pack(std::string_view seq)
+{
+    // Exception runs each encoding would need, to pick the smaller one
+    std::size_t runs[2] = {0, 0};
+    int prev[2] = {-1, -1}; // previous byte while inside an exception run
+    const Codes *tables[2] = {&kDnaCodes, &kProteinCodes};
+    for (const char ch : seq)
+    {
+        const auto c = static_cast<unsigned char>(ch);
+        for (int a = 0; a < 2; ++a)
+        {
+            const bool exception = (*tables[a])[c] < 0;
+            runs[a] += exception && prev[a] != c;
+            prev[a] = exception ? c : -1;
+        }
+    }
+    const std::size_t dna_bytes = words_for(seq.size(), 32) * 8 + runs[0] * sizeof(Run);
+    const std::size_t protein_bytes = words_for(seq.size(), 12) * 8 + runs[1] * sizeof(Run);
+
+    PackedSeq p;
+    p.size_ = seq.size();
+    p.alphabet_ = dna_bytes <= protein_bytes ? Alphabet::Nucleotide : Alphabet::Protein;
+    p.exceptions_.reserve(p.alphabet_ == Alphabet::Nucleotide ? runs[0] : runs[1]);
+    const Codes &codes = p.alphabet_ == Alphabet::Nucleotide ? kDnaCodes : kProteinCodes;
+    const unsigned bits = p.bits(), per = p.per_word();
+
+    const auto add_run = [](std::vector<Run> &runs_out, std::size_t i, char byte)
+    {
+        if (!runs_out.empty() && runs_out.back().end() == i && runs_out.back().byte == byte &&
+            runs_out.back().length != ~std::uint32_t{0})
+            ++runs_out.back().length;
+        else
+            runs_out.push_back(Run{i, 1, byte});
+    };
+
+    p.words_.resize(words_for(seq.size(), per));
+    for (std::size_t w = 0; w < p.words_.size(); ++w)
+    {
+        const std::size_t base = w * per;
+        const std::size_t stop = std::min(seq.size(), base + per);
+        std::uint64_t word = 0;
+        for (std::size_t i = base; i < stop; ++i)
+        {
+            const auto c = static_cast<unsigned char>(seq[i]);
+            const int k = codes[c];
+            if (k >= 0)
+                word |= std::uint64_t(k) << (bits * (i - base));
+            else
+                add_run(p.exceptions_, i, static_cast<char>(c)); // code 0 stands in
+            if (is_lower(c))
+                add_run(p.lower_, i, 0);
+        }
+        p.words_[w] = word;
+    }
+    p.lower_.shrink_to_fit();
+    return p;
+}
+
+std::size_t PackedSeq::packed_bytes() const
+{
+    return words_.capacity() * sizeof(std::uint64_t) + (exceptions_.capacity() + lower_.capacity()) * sizeof(Run);
+}
+
+void PackedSeq::unpack(std::size_t begin, std::size_t end, std::string &out) const
+{
+    end = std::min(end, size_);
+    if (begin >= end)
+        return;
+    const std::size_t at = out.size();
+    out.resize_and_overwrite(at + (end - begin), [&](char *buf, std::size_t)
+                             {
+        char *dst = buf + at;
+        std::size_t i = begin;
+        if (alphabet_ == Alphabet::Nucleotide)
+        {
+            for (; i < end && i % 4; ++i) // up to a byte boundary
+                *dst++ = kDnaLetters[(words_[i / 32] >> (2 * (i % 32))) & 3];
+            for (; i + 4 <= end; i += 4, dst += 4) // four bases per table lookup
+                std::memcpy(dst, kDnaQuads[(words_[i / 32] >> (2 * (i % 32))) & 0xff].data(), 4);
+            for (; i < end; ++i)
+                *dst++ = kDnaLetters[(words_[i / 32] >> (2 * (i % 32))) & 3];
+        }
+        else
+        {
+            while (i < end)
+            { // one word at a time
+                std::uint64_t w = words_[i / 12] >> (5 * (i % 12));
+                const std::size_t stop = std::min(end, (i / 12 + 1) * 12);
+                for (; i < stop; ++i, w >>= 5)
+                    *dst++ = kProteinLetters[w & 31];
+            }
+        }
+        return at + (end - begin); });
+
+    // Runs are sorted by position, so start at the first one reaching begin
+    char *dst = out.data() + at;
+    const auto from = [begin](const std::vector<Run> &runs)
+    { return std::partition_point(runs.begin(), runs.end(), [begin](const Run &r)
+                                  { return r.end() <= begin; }); };
+    for (auto r = from(lower_); r != lower_.end() && r->begin < end; ++r)
+    {
+        for (auto j = std::max<std::uint64_t>(r->begin, begin); j < std::min<std::uint64_t>(r->end(), end); ++j)
+            dst[j - begin] |= 0x20;
+    }
+    for (auto r = from(exceptions_); r != exceptions_.end() && r->begin < end; ++r)
+    {
+        const auto b = std::max<std::uint64_t>(r->begin, begin);
+        std::memset(dst + (b - begin), r->byte, std::min<std::uint64_t>(r->end(), end) - b);
+    }
+}
+
+std::string PackedSeq::unpack() const
+{
+    std::string s;
+    unpack(0, size_, s);
+    return s;
+}
+
+template <unsigned Bits>
+std::uint64_t PackedSeq::codes_at(std::size_t i) const
+{
+    constexpr unsigned per = 64 / Bits;
+    const std::size_t w = i / per, r = i % per;
+    std::uint64_t v = words_[w] >> (Bits * r);
+    if (r && w + 1 < words_.size())
+        v |= words_[w + 1] << (Bits * (per - r));
+    return v & low_bits(Bits * per);
+}
+
+std::size_t PackedSeq::find(std::string_view pattern, std::size_t from) const
+{
+    if (from > size_)
+        return std::string_view::npos;
+    if (pattern.empty())
+        return from;
+    if (pattern.size() > size_ - from)
+        return std::string_view::npos;
+
+    const Codes &codes = alphabet_ == Alphabet::Nucleotide ? kDnaCodes : kProteinCodes;
+    const bool encodable = std::all_of(pattern.begin(), pattern.end(), [&](char ch)
+                                       {
+        const auto c = static_cast<unsigned char>(ch);
+        return codes[c] >= 0 && !is_lower(c); });
+    if (encodable)
+        return alphabet_ == Alphabet::Nucleotide ? find_codes<2>(pattern, from) : find_codes<5>(pattern, from);
+
+    std::string s; // lowercase or exception bytes: compare the bytes themselves
+    unpack(from, size_, s);
+    const std::size_t pos = s.find(pattern);
+    return pos == std::string::npos ? std::string_view::npos : from + pos;
+}
+
+// Windows touching an exception or mask run hold stand-in codes or the
+// wrong case, so only the clean stretches between runs are compared. Within
+// a stretch the first word of pattern codes is checked against every
+// offset of each packed word, the rest only on a hit.
+template <unsigned Bits>
+std::size_t PackedSeq::find_codes(std::string_view pattern, std::size_t from) const
+{
+    constexpr unsigned per = 64 / Bits;
+    const Codes &codes = Bits == 2 ? kDnaCodes : kProteinCodes;
+    const std::size_t m = pattern.size();
+    const std::size_t chunks = words_for(m, per);
+    std::vector<std::uint64_t> want(chunks), mask(chunks); // pattern codes per word-sized chunk
+    for (std::size_t j = 0; j < m; ++j)
+    {
+        want[j / per] |= std::uint64_t(codes[static_cast<unsigned char>(pattern[j])]) << (Bits * (j % per));
+        mask[j / per] |= low_bits(Bits) << (Bits * (j % per));
+    }
+    const std::uint64_t want0 = want[0], mask0 = mask[0];
+    const auto rest_matches = [&](std::size_t i)
+    {
+        for (std::size_t c = 1; c < chunks; ++c)
+        {
+            if ((codes_at<Bits>(i + c * per) & mask[c]) != want[c])
+                return false;
+        }
+        return true;
+    };
+    // Offsets [pos, last] of one clean stretch, a packed word at a time
+    const auto scan = [&](std::size_t pos, std::size_t last)
+    {
+        for (std::size_t w = pos / per; pos <= last; ++w)
+        {
+            const std::uint64_t cur = words_[w];
+            const std::uint64_t next = w + 1 < words_.size() ? words_[w + 1] : 0;
+            const std::size_t base = w * per;
+            const auto stop = static_cast<unsigned>(std::min<std::size_t>(per, last - base + 1));
+            for (auto r = static_cast<unsigned>(pos - base); r < stop; ++r)
+            {
+                // Two shifts so r == 0 stays defined; stray high bits fall outside mask0
+                const std::uint64_t window = (cur >> (Bits * r)) | ((next << 1) << (Bits * (per - r) - 1));
+                if ((window & mask0) == want0 && rest_matches(base + r))
+                    return base + r;
+            }
+            pos = base + per;
+        }
+        return std::string_view::npos;
+    };
+
+    const auto first_after = [from](const std::vector<Run> &runs)
+    { return std::partition_point(runs.begin(), runs.end(), [from](const Run &r)
+                                  { return r.end() <= from; }); };
+    auto e = first_after(exceptions_);
+    auto l = first_after(lower_);
+    std::size_t pos = from;
+    while (pos + m <= size_)
+    {
+        while (e != exceptions_.end() && e->end() <= pos)
+            ++e;
+        while (l != lower_.end() && l->end() <= pos)
+            ++l;
+        if (e != exceptions_.end() && e->begin <= pos)
+        {
+            pos = e->end();
+            continue;
+        }
+        if (l != lower_.end() && l->begin <= pos)
+        {
+            pos = l->end();
+            continue;
+        }
+        std::size_t stop = size_; // [pos, stop) holds plain codes only
+        if (e != exceptions_.end())
+            stop = std::min<std::size_t>(stop, e->begin);
+        if (l != lower_.end())
+            stop = std::min<std::size_t>(stop, l->begin);
+        if (stop - pos >= m)
+        {
+            if (const std::size_t hit = scan(pos, stop - m); hit != std::string_view::npos)
+                return hit;
+        }
+        pos = stop;
+    }
+    return std::string_view::npos;
+}
@@ -0,0 +1,198 @@
+// release_diff.cpp — ID-sorted per-release tables, merge-joined pair by pair
+#include <algorithm>
+#include "obo_engine.hpp"
+#include "release_diff.hpp"
+#include "task_utils.hpp"
+
+const char *change_kind_name(ChangeKind kind)
+{
+    switch (kind)
+    {
+    case ChangeKind::kObsoleted:
+        return "obsoleted";
+    case ChangeKind::kRevived:
+        return "revived";
+    case ChangeKind::kAlternativesChanged:
+        return "alternatives_changed";
+    case ChangeKind::kNamespaceMoved:
+        return "namespace_moved";
+    }
+    return "";
+}
+
+static void append_ids(std::string &out, std::span<const GoId> ids)
+{
+    char buf[GoId::kTextSize];
+    for (std::size_t i = 0; i < ids.size(); ++i)
+    {
+        if (i)
+            out += ',';
+        out.append(buf, ids[i].format(buf));
+    }
+}
+
+// "replaced_by=GO:a,GO:b;consider=GO:c", one cell
+static std::string alternatives(std::span<const GoId> replaced_by, std::span<const GoId> consider)
+{
+    std::string s = "replaced_by=";
+    append_ids(s, replaced_by);
+    s += ";consider=";
+    append_ids(s, consider);
+    return s;
+}
+
+void write_release_change_header(TabWriter &out)
+{
+    static constexpr std::string_view kColumns[] = {"from", "to", "change", "id", "before", "after"};
+    out.row(kColumns);
+}
+
+void write_release_change(TabWriter &out, const ReleaseChange &c)
+{
+    out.cell(*c.from).cell(*c.to).cell(change_kind_name(c.kind)).cell(c.id);
+    switch (c.kind)
+    {
+    case ChangeKind::kNamespaceMoved:
+        out.cell(c.ns_before).cell(c.ns_after);
+        break;
+    case ChangeKind::kObsoleted:
+        out.cell("").cell(alternatives(c.replaced_by_after, c.consider_after));
+        break;
+    case ChangeKind::kRevived:
+        out.cell(alternatives(c.replaced_by_before, c.consider_before)).cell("");
+        break;
+    case ChangeKind::kAlternativesChanged:
+        out.cell(alternatives(c.replaced_by_before, c.consider_before))
+            .cell(alternatives(c.replaced_by_after, c.consider_after));
+        break;
+    }
+    out.end_row();
+}
+
+namespace
+{
+    // One release's table plus its rows in ascending ID order.
+    struct Release
+    {
+        TermTables tables;
+        std::vector<std::uint32_t> order; // rows with a valid ID; first row wins on duplicates
+
+        const TermTableView &view() const { return tables.views.front(); }
+    };
+
+    Release load_release(const std::string &path, unsigned threads, bool use_cache)
+    {
+        Release r;
+        r.tables = load_term_tables({path}, threads, use_cache);
+        const auto &v = r.view();
+        r.order.reserve(v.size());
+        for (std::uint32_t i = 0; i < v.size(); ++i)
+            if (v.id(i).valid())
+                r.order.push_back(i);
+
+        // Releases are written in ID order, so this is usually just the check.
+        auto by_id = [&v](std::uint32_t a, std::uint32_t b)
+        { return v.id(a) < v.id(b); };
+        if (!std::is_sorted(r.order.begin(), r.order.end(), by_id))
+            std::stable_sort(r.order.begin(), r.order.end(), by_id);
+        r.order.erase(std::unique(r.order.begin(), r.order.end(), [&v](std::uint32_t a, std::uint32_t b)
+                                  { return v.id(a) == v.id(b); }),
+                      r.order.end());
+        return r;
+    }
+
+    // Order-insensitive; target lists are a handful of IDs.
+    bool same_targets(std::span<const GoId> a, std::span<const GoId> b)
+    {
+        if (a.size() != b.size())
+            return false;
+        std::vector<GoId> x(a.begin(), a.end()), y(b.begin(), b.end());
+        std::sort(x.begin(), x.end());
+        std::sort(y.begin(), y.end());
+        return x == y;
+    }
+
+    void diff_pair(
+        const Release &before, const Release &after,
+        const std::string &from, const std::string &to,
+        const std::unordered_set<std::string> &ns_filter,
+        const NameFilter *name_filter,
+        const std::function<void(const ReleaseChange &)> &emit)
+    {
+        const auto &a = before.view();
+        const auto &b = after.view();
+        auto wanted = [&](const TermTableView &t, std::uint32_t row)
+        {
+            return namespace_allowed(ns_filter, t.ns(row)) && (!name_filter || name_filter->matches(t.name(row)));
+        };
+
+        std::size_t i = 0, j = 0;
+        while (j < after.order.size())
+        {
+            const bool in_a = i < before.order.size();
+            const GoId ida = in_a ? a.id(before.order[i]) : GoId{};
+            const GoId idb = b.id(after.order[j]);
+            if (in_a && ida < idb)
+            {
+                ++i; // dropped from the newer release; GO never retires IDs this way
+                continue;
+            }
+
+            const std::uint32_t rb = after.order[j++];
+            ReleaseChange c{&from, &to, ChangeKind::kObsoleted, idb, {}, b.ns(rb), {}, b.replaced_by.row(rb), {}, b.consider.row(rb)};
+            if (!in_a || idb < ida)
+            {
+                // New in this release; only interesting if it arrives obsolete.
+                if (b.is_obsolete(rb) && wanted(b, rb))
+                    emit(c);
+                continue;
+            }
+
+            const std::uint32_t ra = before.order[i++];
+            if (!wanted(b, rb))
+                continue;
+            c.ns_before = a.ns(ra);
+            c.replaced_by_before = a.replaced_by.row(ra);
+            c.consider_before = a.consider.row(ra);
+
+            const bool was = a.is_obsolete(ra), is = b.is_obsolete(rb);
+            if (!was && is)
+                emit(c);
+            else if (was && !is)
+            {
+                c.kind = ChangeKind::kRevived;
+                emit(c);
+            }
+            else if (was && is && (!same_targets(c.replaced_by_before, c.replaced_by_after) ||
+                                   !same_targets(c.consider_before, c.consider_after)))
+            {
+                c.kind = ChangeKind::kAlternativesChanged;
+                emit(c);
+            }
+            if (c.ns_before != c.ns_after)
+            {
+                c.kind = ChangeKind::kNamespaceMoved;
+                emit(c);
+            }
+        }
+    }
+} // namespace
+
+void diff_releases(
+    const std::vector<std::string> &releases,
+    const std::unordered_set<std::string> &ns_filter,
+    const NameFilter *name_filter,
+    unsigned threads,
+    bool use_cache,
+    const std::function<void(const ReleaseChange &)> &emit)
+{
+    if (releases.size() < 2)
+        return;
+    Release before = load_release(releases[0], threads, use_cache);
+    for (std::size_t k = 1; k < releases.size(); ++k)
+    {
+        Release after = load_release(releases[k], threads, use_cache);
+        diff_pair(before, after, releases[k - 1], releases[k], ns_filter, name_filter, emit);
+        before = std::move(after); // the older table is released here
+    }
+}
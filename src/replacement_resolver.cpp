@@ -0,0 +1,250 @@
+// replacement_resolver.cpp — replaced_by path compression + consider expansion
+#include <algorithm>
+#include <utility>
+#include "replacement_resolver.hpp"
+
+const char *resolution_name(Resolution r)
+{
+    switch (r)
+    {
+    case Resolution::kLive:
+        return "live";
+    case Resolution::kResolved:
+        return "resolved";
+    case Resolution::kDeadEnd:
+        return "dead_end";
+    case Resolution::kCycle:
+        return "cycle";
+    case Resolution::kUnknown:
+        return "unknown";
+    }
+    return "";
+}
+
+ReplacementResolver::ReplacementResolver(std::span<const TermTableView> tables)
+{
+    std::uint32_t max_number = 0;
+    std::size_t total = 0;
+    for (const auto &t : tables)
+    {
+        total += t.size();
+        for (std::size_t i = 0; i < t.size(); ++i)
+        {
+            if (t.id(i).valid())
+                max_number = std::max(max_number, t.id(i).number());
+            for (const auto alt : t.alt_id.row(i))
+                max_number = std::max(max_number, alt.number());
+        }
+    }
+    index_.assign(total == 0 ? 0 : std::size_t{max_number} + 1, kNoNode);
+
+    // Primary IDs first, so an alt_id never shadows a term of its own.
+    std::vector<std::pair<const TermTableView *, std::size_t>> rows;
+    for (const auto &t : tables)
+        for (std::size_t i = 0; i < t.size(); ++i)
+        {
+            const auto id = t.id(i);
+            if (!id.valid() || index_[id.number()] != kNoNode)
+                continue;
+            index_[id.number()] = static_cast<std::uint32_t>(rows.size());
+            rows.emplace_back(&t, i);
+        }
+    for (std::uint32_t v = 0; v < rows.size(); ++v)
+        for (const auto alt : rows[v].first->alt_id.row(rows[v].second))
+            if (index_[alt.number()] == kNoNode)
+                index_[alt.number()] = v;
+
+    const auto n = static_cast<std::uint32_t>(rows.size());
+    ids_.reserve(n);
+    obsolete_.reserve(n);
+    next_.resize(n);
+    consider_offsets_.reserve(n + 1);
+    consider_offsets_.push_back(0);
+    for (std::uint32_t v = 0; v < n; ++v)
+    {
+        const auto &[t, i] = rows[v];
+        ids_.push_back(t->id(i));
+        obsolete_.push_back(t->is_obsolete(i));
+        next_[v] = v;
+        if (obsolete_[v])
+        {
+            for (const auto target : t->replaced_by.row(i))
+                if (const auto w = node(target); w != kNoNode)
+                {
+                    next_[v] = w;
+                    break;
+                }
+            for (const auto target : t->consider.row(i))
+                if (const auto w = node(target); w != kNoNode)
+                    consider_.push_back(w);
+        }
+        consider_offsets_.push_back(static_cast<std::uint32_t>(consider_.size()));
+    }
+
+    compress_replaced_by();
+    expand_consider();
+}
+
+// Walks each unvisited chain once, stamping the nodes on the current path;
+// meeting a stamped node again means a cycle. Every node on the path is
+// then pointed straight at the chain end (or kNoNode for a cycle).
+void ReplacementResolver::compress_replaced_by()
+{
+    const auto n = static_cast<std::uint32_t>(ids_.size());
+    constexpr std::uint32_t kUnset = kNoNode - 1;
+    root_.assign(n, kUnset);
+    std::vector<std::uint32_t> stamp(n, kNoNode), path;
+    for (std::uint32_t v = 0; v < n; ++v)
+    {
+        if (root_[v] != kUnset)
+            continue;
+        path.clear();
+        std::uint32_t u = v, end = kNoNode;
+        for (;;)
+        {
+            if (root_[u] != kUnset)
+            {
+                end = root_[u];
+                break;
+            }
+            if (stamp[u] == v)
+                break; // cycle: end stays kNoNode
+            stamp[u] = v;
+            path.push_back(u);
+            if (next_[u] == u)
+            {
+                end = u;
+                break;
+            }
+            u = next_[u];
+        }
+        for (const auto p : path)
+            root_[p] = end;
+    }
+}
+
+// Chain ends that are live resolve to themselves. The consider edges
+// between chain ends are collapsed into strongly connected components with
+// Tarjan's algorithm, which finishes every component after all the ones it
+// reaches; a component then takes the union of its members' live IDs and
+// of the targets of the components its edges lead to. Every member of a
+// consider cycle therefore gets the same answer whatever the ID order, and
+// only a component that reaches no live term is reported as a cycle.
+void ReplacementResolver::expand_consider()
+{
+    const auto n = static_cast<std::uint32_t>(ids_.size());
+    std::vector<std::uint32_t> order(n, kNoNode), low(n, 0), comp(n, kNoNode);
+    std::vector<bool> on_stack(n, false);
+    std::vector<bool> cyclic(n, false);               // per component (indexed by its root)
+    std::vector<std::uint32_t> begin(n, 0), count(n, 0); // per component: targets in pool
+    std::vector<GoId> pool, scratch;
+    std::vector<std::uint32_t> members;                // Tarjan stack
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> calls; // (end, next consider to visit)
+    std::uint32_t next_order = 0;
+
+    auto considers = [this](std::uint32_t v)
+    {
+        return std::span<const std::uint32_t>{consider_.data() + consider_offsets_[v], consider_.data() + consider_offsets_[v + 1]};
+    };
+    auto enter = [&](std::uint32_t v)
+    {
+        order[v] = low[v] = next_order++;
+        members.push_back(v);
+        on_stack[v] = true;
+        calls.emplace_back(v, 0);
+    };
+    // Pops the component rooted at r and gives it the union of its targets.
+    auto finish = [&](std::uint32_t r)
+    {
+        const auto first = std::find(members.rbegin(), members.rend(), r).base() - 1;
+        const std::span<const std::uint32_t> scc{&*first, static_cast<std::size_t>(members.end() - first)};
+        for (const auto m : scc)
+        {
+            comp[m] = r;
+            on_stack[m] = false;
+        }
+        bool cyc = scc.size() > 1;
+        scratch.clear();
+        for (const auto m : scc)
+        {
+            if (!obsolete_[m])
+                scratch.push_back(ids_[m]);
+            for (const auto c : considers(m))
+            {
+                const auto e = root_[c];
+                if (e == kNoNode || comp[e] == r)
+                {
+                    cyc = true; // into a replaced_by cycle, or back into this component
+                    continue;
+                }
+                const auto ce = comp[e];
+                scratch.insert(scratch.end(), pool.begin() + begin[ce], pool.begin() + begin[ce] + count[ce]);
+                if (count[ce] == 0 && cyclic[ce])
+                    cyc = true;
+            }
+        }
+        std::sort(scratch.begin(), scratch.end());
+        scratch.erase(std::unique(scratch.begin(), scratch.end()), scratch.end());
+        begin[r] = static_cast<std::uint32_t>(pool.size());
+        count[r] = static_cast<std::uint32_t>(scratch.size());
+        pool.insert(pool.end(), scratch.begin(), scratch.end());
+        cyclic[r] = cyc;
+        members.erase(first, members.end());
+    };
+
+    for (std::uint32_t s = 0; s < n; ++s)
+    {
+        if (root_[s] != s || order[s] != kNoNode)
+            continue;
+        enter(s);
+        while (!calls.empty())
+        {
+            const auto v = calls.back().first;
+            const auto cs = considers(v);
+            if (calls.back().second < cs.size())
+            {
+                const auto e = root_[cs[calls.back().second++]];
+                if (e == kNoNode)
+                    continue;
+                if (order[e] == kNoNode)
+                    enter(e);
+                else if (on_stack[e])
+                    low[v] = std::min(low[v], order[e]);
+                continue;
+            }
+            calls.pop_back();
+            if (!calls.empty())
+                low[calls.back().first] = std::min(low[calls.back().first], low[v]);
+            if (low[v] == order[v])
+                finish(v);
+        }
+    }
+
+    offsets_.assign(n + 1, 0);
+    status_.resize(n);
+    for (std::uint32_t v = 0; v < n; ++v)
+    {
+        offsets_[v + 1] = offsets_[v] + (root_[v] == v ? count[comp[v]] : 0);
+        const auto e = root_[v];
+        if (!obsolete_[v])
+            status_[v] = Resolution::kLive;
+        else if (e == kNoNode)
+            status_[v] = Resolution::kCycle;
+        else if (count[comp[e]] > 0)
+            status_[v] = Resolution::kResolved;
+        else
+            status_[v] = cyclic[comp[e]] ? Resolution::kCycle : Resolution::kDeadEnd;
+    }
+    targets_.reserve(offsets_[n]);
+    for (std::uint32_t v = 0; v < n; ++v)
+        if (root_[v] == v)
+        {
+            const auto c = comp[v];
+            targets_.insert(targets_.end(), pool.begin() + begin[c], pool.begin() + begin[c] + count[c]);
+        }
+}
+
+void write_resolution_row(TabWriter &out, GoId id, Resolution status, std::span<const GoId> targets)
+{
+    out.cell(id).cell(resolution_name(status)).cell(targets).end_row();
+}
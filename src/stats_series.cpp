@@ -0,0 +1,121 @@
+// stats_series.cpp — .gostats read/write + per-release stats series
+#include <fstream>
+#include <sstream>
+#include "obo_engine.hpp"
+#include "stats_series.hpp"
+#include "task_utils.hpp"
+#include "term_table.hpp"
+
+namespace
+{
+    constexpr const char *kMagic = "GOSTATS";
+    constexpr int kVersion = 1;
+
+    // Text, one namespace per line:
+    //   GOSTATS 1
+    //   size mtime_ns content_hash path_hash
+    //   namespace <tab> obsolete_total <tab> with_alternatives <tab> with_replaced_by <tab> consider_only <tab> no_alternative
+    bool load_stats(const std::string &obo_path, std::map<std::string, NamespaceStats> &out)
+    {
+        std::ifstream in(stats_cache_path_for(obo_path));
+        std::string magic;
+        int version = 0;
+        CacheKey key;
+        if (!(in >> magic >> version) || magic != kMagic || version != kVersion ||
+            !(in >> key.source_size >> key.source_mtime_ns >> key.content_hash >> key.path_hash) ||
+            !cache_key_matches(obo_path, key))
+            return false;
+        in.ignore(1); // end of the key line
+
+        std::map<std::string, NamespaceStats> stats;
+        for (std::string line; std::getline(in, line);)
+        {
+            const auto tab = line.find('\t');
+            if (tab == std::string::npos)
+                return false;
+            NamespaceStats st;
+            std::istringstream fields(line.substr(tab + 1));
+            if (!(fields >> st.obsolete_total >> st.with_alternatives >> st.with_replaced_by >> st.consider_only >> st.no_alternative))
+                return false;
+            stats[line.substr(0, tab)] = st;
+        }
+        if (!stats.count("all"))
+            return false;
+        out = std::move(stats);
+        return true;
+    }
+
+    void store_stats(const std::string &obo_path, const CacheKey &key, const std::map<std::string, NamespaceStats> &stats)
+    {
+        std::ostringstream out;
+        out << kMagic << ' ' << kVersion << '\n'
+            << key.source_size << ' ' << key.source_mtime_ns << ' ' << key.content_hash << ' ' << key.path_hash << '\n';
+        for (const auto &[ns, st] : stats)
+            out << ns << '\t' << st.obsolete_total << '\t' << st.with_alternatives << '\t'
+                << st.with_replaced_by << '\t' << st.consider_only << '\t' << st.no_alternative << '\n';
+        const std::string text = out.str();
+        const std::string_view bytes = text;
+        replace_file(stats_cache_path_for(obo_path), {&bytes, 1}); // on failure: recompute next time
+    }
+
+    // Terms without a namespace never pass a non-empty filter, so "all" is
+    // the sum of the allowed namespaces.
+    std::map<std::string, NamespaceStats> restrict_namespaces(
+        const std::map<std::string, NamespaceStats> &stats, const std::unordered_set<std::string> &ns_filter)
+    {
+        if (ns_filter.empty())
+            return stats;
+        std::map<std::string, NamespaceStats> out;
+        auto &all = out["all"];
+        for (const auto &[ns, st] : stats)
+            if (ns != "all" && namespace_allowed(ns_filter, ns))
+            {
+                out[ns] = st;
+                all += st;
+            }
+        return out;
+    }
+} // namespace
+
+std::string stats_cache_path_for(const std::string &obo_path)
+{
+    return obo_path + ".gostats";
+}
+
+std::map<std::string, NamespaceStats> release_obsolete_stats(const std::string &obo_path, unsigned threads, bool use_cache)
+{
+    if (!use_cache)
+        return scan_obo_files({obo_path}, {}, nullptr, kObsoleteStats, threads, false).obsolete_stats;
+
+    std::map<std::string, NamespaceStats> stats;
+    if (load_stats(obo_path, stats))
+        return stats;
+
+    // Keyed on the bytes before the scan (stat'ed before they are read), so
+    // a file rewritten meanwhile just misses next time. .gostats is this
+    // mode's cache: the scan neither reads nor writes a .gocache.
+    auto key = stat_cache_key(obo_path);
+    key.content_hash = hash_cache_contents(MappedFile(obo_path).view());
+    stats = scan_obo_files({obo_path}, {}, nullptr, kObsoleteStats, threads, false).obsolete_stats;
+    store_stats(obo_path, key, stats);
+    return stats;
+}
+
+std::vector<std::map<std::string, NamespaceStats>> obsolete_stats_series(
+    const std::vector<std::string> &releases,
+    const std::unordered_set<std::string> &ns_filter,
+    const NameFilter *name_filter,
+    unsigned threads,
+    bool use_cache)
+{
+    std::vector<std::map<std::string, NamespaceStats>> series;
+    series.reserve(releases.size());
+    for (const auto &r : releases)
+    {
+        if (name_filter)
+            series.push_back(scan_obo_files({r}, ns_filter, name_filter, kObsoleteStats, threads, use_cache).obsolete_stats);
+        else
+            series.push_back(restrict_namespaces(release_obsolete_stats(r, threads, use_cache), ns_filter));
+    }
+    return series;
+}
@@ -0,0 +1,169 @@
+// tab_writer.cpp — TabWriter buffer management and write()/writev() flushing
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include "tab_writer.hpp"
+
+TabWriter::TabWriter(int fd, bool owns_fd, std::string name)
+    : capacity_(kBufferBytes), buf_(std::make_unique_for_overwrite<char[]>(capacity_)), fd_(fd), owns_fd_(owns_fd),
+      name_(std::move(name))
+{
+}
+
+TabWriter::TabWriter(std::string &out)
+    : capacity_(kStringBufferBytes), buf_(std::make_unique_for_overwrite<char[]>(capacity_)), str_(&out)
+{
+}
+
+TabWriter::~TabWriter()
+{
+    flush();
+    if (owns_fd_ && fd_ >= 0)
+        ::close(fd_);
+}
+
+char *TabWriter::reserve(std::size_t n)
+{
+    if (capacity_ - used_ < n)
+        write_out({});
+    return buf_.get() + used_;
+}
+
+void TabWriter::separate()
+{
+    if (row_open_)
+        *reserve(1) = '\t', ++used_;
+    row_open_ = true;
+}
+
+TabWriter &TabWriter::cell(std::string_view s)
+{
+    separate();
+    if (s.size() > capacity_ / 2)
+    {
+        write_out(s);
+        return *this;
+    }
+    std::memcpy(reserve(s.size()), s.data(), s.size());
+    used_ += s.size();
+    return *this;
+}
+
+TabWriter &TabWriter::cell(std::uint64_t n)
+{
+    separate();
+    char *at = reserve(20);
+    used_ = static_cast<std::size_t>(std::to_chars(at, at + 20, n).ptr - buf_.get());
+    return *this;
+}
+
+TabWriter &TabWriter::cell(GoId id)
+{
+    separate();
+    used_ = static_cast<std::size_t>(id.format(reserve(GoId::kTextSize)) - buf_.get());
+    return *this;
+}
+
+TabWriter &TabWriter::cell(std::span<const GoId> ids)
+{
+    separate();
+    for (std::size_t i = 0; i < ids.size(); ++i)
+    {
+        char *at = reserve(GoId::kTextSize + 1);
+        if (i)
+            *at++ = ',';
+        used_ = static_cast<std::size_t>(ids[i].format(at) - buf_.get());
+    }
+    return *this;
+}
+
+void TabWriter::end_row()
+{
+    *reserve(1) = '\n';
+    ++used_;
+    row_open_ = false;
+}
+
+void TabWriter::row(std::span<const std::string_view> cells)
+{
+    for (const auto c : cells)
+        cell(c);
+    end_row();
+}
+
+bool TabWriter::flush()
+{
+    write_out({});
+    return ok_;
+}
+
+void TabWriter::write_out(std::string_view extra)
+{
+    if (str_)
+    {
+        str_->append(buf_.get(), used_);
+        str_->append(extra);
+        used_ = 0;
+        return;
+    }
+
+    iovec iov[2] = {{buf_.get(), used_}, {const_cast<char *>(extra.data()), extra.size()}};
+    iovec *next = iov;
+    int count = extra.empty() ? 1 : 2;
+    while (ok_ && count > 0)
+    {
+        if (next->iov_len == 0)
+        {
+            ++next, --count;
+            continue;
+        }
+        const ssize_t n = count == 1 ? ::write(fd_, next->iov_base, next->iov_len) : ::writev(fd_, next, count);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            std::cerr << "Error: cannot write " << name_ << ": " << std::strerror(errno) << "\n";
+            ok_ = false;
+            break;
+        }
+        // Partial writes: skip what went out and retry the rest.
+        for (auto left = static_cast<std::size_t>(n); left > 0 && count > 0;)
+        {
+            const auto step = std::min(left, next->iov_len);
+            next->iov_base = static_cast<char *>(next->iov_base) + step;
+            next->iov_len -= step;
+            left -= step;
+            if (next->iov_len == 0)
+                ++next, --count;
+        }
+    }
+    used_ = 0;
+}
+
+int open_tab_file(const std::string &path)
+{
+    if (!path.ends_with(".tab"))
+    {
+        std::cerr << "Error: --output must end with .tab\n";
+        return -1;
+    }
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+    if (fd < 0)
+        std::cerr << "Error: cannot open output: " << path << ": " << std::strerror(errno) << "\n";
+    return fd;
+}
+
+std::optional<TabWriter> open_tab_output(const std::optional<std::string> &path)
+{
+    if (!path)
+        return std::optional<TabWriter>(std::in_place, STDOUT_FILENO);
+    const int fd = open_tab_file(*path);
+    if (fd < 0)
+        return std::nullopt;
+    return std::optional<TabWriter>(std::in_place, fd, true, *path);
+}
@@ -1,4 +1,5 @@
 // task1.cpp — Task 1: CLI with validation and subcommands
+#include <algorithm>
 #include <iostream>
 #include "task_utils.hpp"
 
@@ -6,10 +7,20 @@ int main(int argc, char **argv)
 {
     const auto opts = parse_task1_cli(argc, argv);
 
-    std::cout << "Mode: " << (opts.consider_table ? "consider-table" : "obsolete-stats") << "\n";
+    const char *mode = opts.diff_releases                          ? "diff-releases"
+                       : opts.resolve_replacements                 ? "resolve-replacements"
+                       : opts.serve_socket                         ? "serve"
+                       : opts.time_series                          ? "time-series"
+                       : opts.consider_table && opts.obsolete_stats ? "combined"
+                       : opts.consider_table                      ? "consider-table"
+                                                                  : "obsolete-stats";
+    std::cout << "Mode: " << mode << "\n";
     std::cout << "Files:\n";
     for (auto &f : opts.obo_files)
-        std::cout << "  " << f << "\n";
+    {
+        const bool cached = std::find(opts.cached_files.begin(), opts.cached_files.end(), f) != opts.cached_files.end();
+        std::cout << "  " << f << (cached ? " (cached)" : "") << "\n";
+    }
     if (!opts.namespaces.empty())
     {
         std::cout << "Namespaces:";
@@ -1,25 +1,103 @@
-// task2.cpp — Task 2: run consider-table over inputs
+// task2.cpp — Task 2: run consider-table (or --diff-releases) over inputs
 #include <iostream>
-#include <regex>
+#include "obo_engine.hpp"
+#include "release_diff.hpp"
+#include "replacement_resolver.hpp"
 #include "task_utils.hpp"
 #include "task2_utils.hpp"
 
+static int run_diff_releases(const CLIOptions &opts)
+{
+    if (opts.obo_files.size() < 2)
+    {
+        std::cerr << "Error: --diff-releases needs at least two releases.\n";
+        return 1;
+    }
+    const NameFilter *pat = opts.name_pattern ? &*opts.name_pattern : nullptr;
+    auto out = open_tab_output(opts.output_tab);
+    if (!out)
+        return 1;
+    try
+    {
+        write_release_change_header(*out);
+        diff_releases(opts.obo_files, opts.namespaces, pat, opts.threads, opts.use_cache,
+                      [&out](const ReleaseChange &c)
+                      { write_release_change(*out, c); });
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return out->flush() ? 0 : 1;
+}
+
+static int run_resolve_replacements(const CLIOptions &opts)
+{
+    const NameFilter *pat = opts.name_pattern ? &*opts.name_pattern : nullptr;
+    try
+    {
+        const auto tables = load_term_tables(opts.obo_files, opts.threads, opts.use_cache);
+        const ReplacementResolver resolver(tables.views);
+        auto out = open_tab_output(opts.output_tab);
+        if (!out)
+            return 1;
+        std::unordered_set<GoId> written; // the first input that lists an ID wins, as in the resolver
+        for (const auto &t : tables.views)
+            for (std::size_t i = 0; i < t.size(); ++i)
+            {
+                const auto id = t.id(i);
+                if (!t.is_obsolete(i) || !written.insert(id).second)
+                    continue;
+                const auto status = resolver.status(id);
+                if (status == Resolution::kLive || !namespace_allowed(opts.namespaces, t.ns(i)) ||
+                    (pat && !pat->matches(t.name(i))))
+                    continue;
+                write_resolution_row(*out, id, status, resolver.targets(id));
+            }
+        return out->flush() ? 0 : 1;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
+
 int main(int argc, char **argv)
 {
     const auto opts = parse_task1_cli(argc, argv);
+    if (opts.diff_releases)
+        return run_diff_releases(opts);
+    if (opts.resolve_replacements)
+        return run_resolve_replacements(opts);
     if (!opts.consider_table)
     {
         std::cerr << "Error: Task 2 expects --consider-table mode.\n";
         return 1;
     }
+    if (opts.obsolete_stats)
+    {
+        std::cerr << "Error: --combined also writes stats; run it through task3.\n";
+        return 1;
+    }
 
-    const std::regex *pat = opts.name_pattern ? &*opts.name_pattern : nullptr;
-    const auto rows = build_consider_table(opts.obo_files, opts.namespaces, pat);
-
-    for (const auto &r : rows)
+    const NameFilter *pat = opts.name_pattern ? &*opts.name_pattern : nullptr;
+    std::vector<ConsiderRow> rows;
+    try
+    {
+        rows = build_consider_table(opts.obo_files, opts.namespaces, pat, opts.threads, opts.use_cache);
+    }
+    catch (const std::exception &e)
     {
-        // GO:obsolete_id <tab> alt_ids_csv <tab> parent_id
-        std::cout << r.obsolete_id << '\t' << r.alternatives_csv << '\t' << r.parent_id << '\n';
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
     }
-    return 0;
+
+    auto out = open_tab_output(opts.output_tab);
+    if (!out)
+        return 1;
+    for (const auto &r : rows)
+        write_consider_row(*out, r);
+    return out->flush() ? 0 : 1;
 }
@@ -1,24 +1,54 @@
-// task3.cpp — Task 3: stats + optional --output FILE.tab
+// task3.cpp — Task 3: stats + optional --output FILE.tab (and --combined)
 #include <iostream>
+#include <unistd.h>
+#include "go_server.hpp"
+#include "obo_engine.hpp"
+#include "stats_series.hpp"
 #include "task_utils.hpp"
+#include "tab_writer.hpp"
 #include "task3_utils.hpp"
 
-static std::vector<std::vector<std::string>>
-stats_to_rows(const std::map<std::string, NamespaceStats> &m)
+int main(int argc, char **argv)
 {
-    std::vector<std::vector<std::string>> rows;
-    rows.reserve(m.size() + 1);
-    rows.push_back({"namespace", "obsolete_total", "with_alternatives"});
-    for (const auto &[ns, st] : m)
+    auto opts = parse_task1_cli(argc, argv);
+
+    if (opts.serve_socket)
     {
-        rows.push_back({ns, std::to_string(st.obsolete_total), std::to_string(st.with_alternatives)});
+        try
+        {
+            GoServer server(opts.obo_files, opts.threads, opts.use_cache);
+            server.serve(*opts.serve_socket, opts.threads);
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "Error: " << e.what() << "\n";
+            return 1;
+        }
+        return 0;
     }
-    return rows;
-}
 
-int main(int argc, char **argv)
-{
-    auto opts = parse_task1_cli(argc, argv);
+    const NameFilter *pat = opts.name_pattern ? &*opts.name_pattern : nullptr;
+    if (opts.time_series)
+    {
+        std::vector<std::map<std::string, NamespaceStats>> series;
+        try
+        {
+            series = obsolete_stats_series(opts.obo_files, opts.namespaces, pat, opts.threads, opts.use_cache);
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "Error: " << e.what() << "\n";
+            return 1;
+        }
+        auto out = open_tab_output(opts.output_tab);
+        if (!out)
+            return 1;
+        // One row per (release, namespace), releases in input order.
+        write_stats_header(*out, true);
+        for (std::size_t r = 0; r < series.size(); ++r)
+            write_stats_rows(*out, series[r], opts.obo_files[r]);
+        return out->flush() ? 0 : 1;
+    }
 
     // Task 3 uses obsolete-stats mode (and optional --output FILE.tab)
     if (!opts.obsolete_stats)
@@ -27,28 +57,38 @@ int main(int argc, char **argv)
         return 1;
     }
 
-    const std::regex *pat = opts.name_pattern ? &*opts.name_pattern : nullptr;
-    const auto stats = compute_obsolete_stats(opts.obo_files, opts.namespaces, pat);
-    const auto rows = stats_to_rows(stats);
+    // --combined: one read feeds both the consider-table and the stats
+    const unsigned outputs = kObsoleteStats | (opts.consider_table ? kConsiderRows : 0u);
 
-    if (opts.output_tab)
+    ScanResult scan;
+    try
     {
-        if (!write_tab_file(*opts.output_tab, rows))
-            return 1;
+        scan = scan_obo_files(opts.obo_files, opts.namespaces, pat, outputs, opts.threads, opts.use_cache);
     }
-    else
+    catch (const std::exception &e)
     {
-        // Print to terminal
-        for (const auto &r : rows)
-        {
-            for (size_t i = 0; i < r.size(); ++i)
-            {
-                if (i)
-                    std::cout << '\t';
-                std::cout << r[i];
-            }
-            std::cout << '\n';
-        }
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    TabWriter console(STDOUT_FILENO);
+    for (const auto &r : scan.consider_rows)
+        write_consider_row(console, r);
+    if (!opts.output_tab)
+    {
+        if (opts.consider_table)
+            console.end_row();
+        write_stats_header(console);
+        write_stats_rows(console, scan.obsolete_stats);
+        return console.flush() ? 0 : 1;
     }
-    return 0;
+    if (!console.flush())
+        return 1;
+
+    auto out = open_tab_output(opts.output_tab);
+    if (!out)
+        return 1;
+    write_stats_header(*out);
+    write_stats_rows(*out, scan.obsolete_stats);
+    return out->flush() ? 0 : 1;
 }
@@ -1,49 +1,36 @@
-// task3_utils.cpp — Task 3 impl stubs (compile-ready)
-#include <filesystem>
-#include <fstream>
-#include <iostream>
+// task3_utils.cpp — Task 3: obsolete-term stats + .tab output
 #include <map>
-#include <regex>
 #include <unordered_set>
 #include <vector>
+#include "obo_engine.hpp"
 #include "task3_utils.hpp"
 
-namespace fs = std::filesystem;
-
 std::map<std::string, NamespaceStats> compute_obsolete_stats(
     const std::vector<std::string> &obo_files,
     const std::unordered_set<std::string> &ns_filter,
-    const std::regex *name_filter)
+    const NameFilter *name_filter,
+    unsigned threads,
+    bool use_cache)
 {
-    std::map<std::string, NamespaceStats> out;
-    // TODO: Implement streaming parse; aggregate per-namespace counts
-    // Hint: if ns_filter empty, aggregate into "all" only or into actual namespaces then also sum to "all".
-    return out;
+    return scan_obo_files(obo_files, ns_filter, name_filter, kObsoleteStats, threads, use_cache).obsolete_stats;
 }
 
-bool write_tab_file(const std::string &path,
-                    const std::vector<std::vector<std::string>> &rows)
+void write_stats_header(TabWriter &out, bool with_release)
 {
-    if (path.size() < 4 || path.substr(path.size() - 4) != ".tab")
-    {
-        std::cerr << "Error: --output must end with .tab\n";
-        return false;
-    }
-    std::ofstream out(path);
-    if (!out)
-    {
-        std::cerr << "Error: cannot open output: " << path << "\n";
-        return false;
-    }
-    for (const auto &r : rows)
+    static constexpr std::string_view kColumns[] = {"namespace", "obsolete_total", "with_alternatives",
+                                                    "with_replaced_by", "consider_only", "no_alternative"};
+    if (with_release)
+        out.cell("release");
+    out.row(kColumns);
+}
+
+void write_stats_rows(TabWriter &out, const std::map<std::string, NamespaceStats> &stats, std::string_view release)
+{
+    for (const auto &[ns, st] : stats)
     {
-        for (size_t i = 0; i < r.size(); ++i)
-        {
-            if (i)
-                out << '\t';
-            out << r[i];
-        }
-        out << '\n';
+        if (!release.empty())
+            out.cell(release);
+        out.cell(ns).cell(st.obsolete_total).cell(st.with_alternatives).cell(st.with_replaced_by)
+            .cell(st.consider_only).cell(st.no_alternative).end_row();
     }
-    return true;
 }
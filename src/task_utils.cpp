@@ -1,12 +1,14 @@
 // task_utils.cpp — shared utils impl
 #include <algorithm>
 #include <cctype>
+#include <charconv>
 #include <filesystem>
 #include <iostream>
 #include <regex>
 #include <unordered_map>
 #include <unordered_set>
 #include "task_utils.hpp"
+#include "term_table.hpp"
 
 namespace fs = std::filesystem;
 
@@ -20,10 +22,11 @@ static std::string to_lower(std::string s)
 
 bool has_obo_ext_ci(const std::string &path)
 {
-    auto lower = to_lower(path);
-    if (lower.size() < 4)
-        return false;
-    return lower.rfind(".obo") == lower.size() - 4;
+    const auto lower = to_lower(path);
+    for (const std::string_view ext : {".obo", ".obo.gz", ".obo.xz", ".obo.zst"})
+        if (lower.ends_with(ext))
+            return true;
+    return false;
 }
 
 bool is_valid_namespace(const std::string &ns)
@@ -44,10 +47,43 @@ void normalize_and_validate_namespaces(const std::vector<std::string> &raw,
     }
 }
 
+std::vector<std::string> split_csv(std::string_view csv)
+{
+    std::vector<std::string> out;
+    std::string cur;
+    for (char c : csv)
+    {
+        if (c == ',')
+        {
+            if (!cur.empty())
+            {
+                out.push_back(cur);
+                cur.clear();
+            }
+        }
+        else
+            cur.push_back(c);
+    }
+    if (!cur.empty())
+        out.push_back(cur);
+    return out;
+}
+
+bool namespace_allowed(const std::unordered_set<std::string> &filter, std::string_view ns)
+{
+    if (filter.empty())
+        return true;
+    for (const auto &allowed : filter) // at most three entries
+        if (allowed == ns)
+            return true;
+    return false;
+}
+
 void validate_input_files(const std::vector<std::string> &files,
                           std::vector<std::string> &valid,
                           std::vector<std::string> &invalid_ext,
-                          std::vector<std::string> &missing)
+                          std::vector<std::string> &missing,
+                          std::vector<std::string> *fresh_cache)
 {
     for (const auto &f : files)
     {
@@ -62,6 +98,8 @@ void validate_input_files(const std::vector<std::string> &files,
             continue;
         }
         valid.push_back(f);
+        if (fresh_cache && cache_is_fresh(f))
+            fresh_cache->push_back(f);
     }
 }
 
@@ -69,16 +107,39 @@ void print_usage(const std::string &prog)
 {
     std::cout
         << "Usage (quick):\n"
-        << "  " << prog << " --consider-table <OBO...> [--namespace NS[,NS...]] [--pattern REGEX]\n"
-        << "  " << prog << " --obsolete-stats <OBO...> [--namespace NS[,NS...]] [--pattern REGEX]\n"
+        << "  " << prog << " --consider-table <OBO...> [--output FILE.tab] [--namespace NS[,NS...]] [--pattern REGEX] [--threads N] [--no-cache]\n"
+        << "  " << prog << " --obsolete-stats <OBO...> [--output FILE.tab] [--namespace NS[,NS...]] [--pattern REGEX] [--threads N] [--no-cache]\n"
+        << "  " << prog << " --combined <OBO...> [--output FILE.tab] [--namespace NS[,NS...]] [--pattern REGEX] [--threads N] [--no-cache]\n"
+        << "  " << prog << " --diff-releases <OLDEST.obo ... NEWEST.obo> [--output FILE.tab] [--namespace NS[,NS...]] [--pattern REGEX] [--threads N] [--no-cache]\n"
+        << "  " << prog << " --resolve-replacements <FILE1.obo> [FILE2.obo ...] [--output FILE.tab] [--namespace NS[,NS...]] [--pattern REGEX] [--threads N] [--no-cache]\n"
+        << "  " << prog << " --time-series <OBO...> [--output FILE.tab] [--namespace NS[,NS...]] [--pattern REGEX] [--threads N] [--no-cache]\n"
+        << "  " << prog << " --serve <SOCKET> <OBO...> [--threads N] [--no-cache]\n"
         << "  " << prog << " --help\n\n"
         << "Namespaces: molecular_function, cellular_component, biological_process\n"
         << "Notes:\n"
-        << "  • Files must have .obo (case-insensitive) and exist\n"
+        << "  • Files must have .obo, .obo.gz, .obo.xz or .obo.zst (case-insensitive) and exist;\n"
+        << "    compressed releases are inflated on a separate thread while they are parsed\n"
         << "  • --pattern filters GO term names by regex\n"
+        << "  • --combined prints the consider-table and writes obsolete-stats (to --output if given)\n"
+        << "    from one read of each file\n"
+        << "  • --diff-releases reports terms obsoleted, revived, given new consider/replaced_by\n"
+        << "    targets, or moved to another namespace between each pair of neighbouring releases\n"
+        << "  • --resolve-replacements follows replaced_by (else consider) through obsolete terms\n"
+        << "    and prints: obsolete_id, live/resolved/dead_end/cycle, final live targets\n"
+        << "  • --time-series (task3) prints obsolete-stats per release; each release's totals are\n"
+        << "    cached as <file>.gostats, so only new or changed releases are parsed again\n"
+        << "  • --serve (task3) loads the releases once and answers one request per line on SOCKET:\n"
+        << "    PING | LOOKUP GO:id | RESOLVE GO:id | ANCESTORS GO:id | DESCENDANTS GO:id [relation=is_a|part_of]\n"
+        << "    | CONSIDER [namespace=NS,..] [pattern=REGEX]\n"
+        << "    | STATS [namespace=NS,..] [pattern=REGEX] | QUIT; replies are \"OK <n>\" + n lines or \"ERR msg\"\n"
+        << "  • --threads N parses with N worker threads (default: all cores)\n"
+        << "  • Parsed releases are cached next to each input as <file>.gocache and reused\n"
+        << "    while the file is unchanged; --no-cache skips the cache\n"
         << "Examples:\n"
         << "  " << prog << " --consider-table go-2020-01.obo go-2021-01.obo --namespace molecular_function --pattern \".*ribosome.*\"\n"
-        << "  " << prog << " --obsolete-stats go-2020-01.obo --namespace cellular_component,biological_process\n";
+        << "  " << prog << " --obsolete-stats go-2020-01.obo --namespace cellular_component,biological_process\n"
+        << "  " << prog << " --diff-releases go-2020-01.obo go-2021-01.obo go-2022-01.obo.gz\n"
+        << "  " << prog << " --time-series releases/go-*.obo --output obsolete_by_month.tab\n";
 }
 
 CLIOptions parse_task1_cli(int argc, char **argv)
@@ -94,6 +155,21 @@ CLIOptions parse_task1_cli(int argc, char **argv)
     mode.add_argument("--obsolete-stats")
         .help("Print stats on obsolete GO terms")
         .nargs(argparse::nargs_pattern::at_least_one);
+    mode.add_argument("--combined")
+        .help("Consider-table and obsolete-stats from a single read")
+        .nargs(argparse::nargs_pattern::at_least_one);
+    mode.add_argument("--diff-releases")
+        .help("Obsolescence changes between consecutive releases (oldest first)")
+        .nargs(argparse::nargs_pattern::at_least_one);
+    mode.add_argument("--resolve-replacements")
+        .help("Final live replacement(s) of every obsolete term, following replaced_by/consider chains")
+        .nargs(argparse::nargs_pattern::at_least_one);
+    mode.add_argument("--time-series")
+        .help("Obsolete-stats per release, one row per (release, namespace)")
+        .nargs(argparse::nargs_pattern::at_least_one);
+    mode.add_argument("--serve")
+        .help("SOCKET then OBO files: keep the releases loaded and answer queries on a Unix socket")
+        .nargs(argparse::nargs_pattern::at_least_one);
 
     program.add_argument("--namespace")
         .help("Comma-separated namespaces (mf, cc, bp full names)")
@@ -103,6 +179,19 @@ CLIOptions parse_task1_cli(int argc, char **argv)
         .help("Regex for GO term name filter")
         .default_value(std::string{});
 
+    program.add_argument("--output")
+        .help("Write the table (stats in task3) to FILE.tab instead of the terminal")
+        .default_value(std::string{});
+
+    program.add_argument("--threads")
+        .help("Worker threads (0 => all cores)")
+        .default_value(std::string{"0"});
+
+    program.add_argument("--no-cache")
+        .help("Parse the text and leave <file>.gocache snapshots alone")
+        .default_value(false)
+        .implicit_value(true);
+
     try
     {
         program.parse_args(argc, argv);
@@ -128,6 +217,33 @@ CLIOptions parse_task1_cli(int argc, char **argv)
         opts.obsolete_stats = true;
         inputs = program.get<std::vector<std::string>>("obsolete-stats");
     }
+    else if (program.is_used("combined"))
+    {
+        opts.consider_table = true;
+        opts.obsolete_stats = true;
+        inputs = program.get<std::vector<std::string>>("combined");
+    }
+    else if (program.is_used("diff-releases"))
+    {
+        opts.diff_releases = true;
+        inputs = program.get<std::vector<std::string>>("diff-releases");
+    }
+    else if (program.is_used("resolve-replacements"))
+    {
+        opts.resolve_replacements = true;
+        inputs = program.get<std::vector<std::string>>("resolve-replacements");
+    }
+    else if (program.is_used("time-series"))
+    {
+        opts.time_series = true;
+        inputs = program.get<std::vector<std::string>>("time-series");
+    }
+    else if (program.is_used("serve"))
+    {
+        inputs = program.get<std::vector<std::string>>("serve");
+        opts.serve_socket = inputs.front();
+        inputs.erase(inputs.begin());
+    }
 
     if (inputs.empty())
     {
@@ -141,24 +257,7 @@ CLIOptions parse_task1_cli(int argc, char **argv)
     const auto ns_csv = program.get<std::string>("--namespace");
     if (!ns_csv.empty())
     {
-        std::vector<std::string> raw;
-        std::string cur;
-        for (char c : ns_csv)
-        {
-            if (c == ',')
-            {
-                if (!cur.empty())
-                {
-                    raw.push_back(cur);
-                    cur.clear();
-                }
-            }
-            else
-                cur.push_back(c);
-        }
-        if (!cur.empty())
-            raw.push_back(cur);
-        normalize_and_validate_namespaces(raw, opts.namespaces);
+        normalize_and_validate_namespaces(split_csv(ns_csv), opts.namespaces);
         if (opts.namespaces.empty())
         {
             std::cerr << "Warning: provided namespaces invalid; ignoring filter.\n";
@@ -171,7 +270,7 @@ CLIOptions parse_task1_cli(int argc, char **argv)
     {
         try
         {
-            opts.name_pattern.emplace(pat, std::regex::ECMAScript);
+            opts.name_pattern.emplace(pat);
         }
         catch (const std::exception &e)
         {
@@ -181,15 +280,32 @@ CLIOptions parse_task1_cli(int argc, char **argv)
         }
     }
 
+    // table output file (.tab is checked by open_tab_file)
+    const auto output = program.get<std::string>("--output");
+    if (!output.empty())
+        opts.output_tab = output;
+
+    // worker threads
+    const auto threads = program.get<std::string>("--threads");
+    const auto [end, ec] = std::from_chars(threads.data(), threads.data() + threads.size(), opts.threads);
+    if (ec != std::errc{} || end != threads.data() + threads.size())
+    {
+        std::cerr << "Error: --threads expects a non-negative integer, got '" << threads << "'\n\n";
+        print_usage(argv[0]);
+        std::exit(1);
+    }
+
+    opts.use_cache = !program.is_used("--no-cache");
+
     // file validation
     std::vector<std::string> valid, invalid_ext, missing;
-    validate_input_files(opts.obo_files, valid, invalid_ext, missing);
+    validate_input_files(opts.obo_files, valid, invalid_ext, missing, opts.use_cache ? &opts.cached_files : nullptr);
 
     if (!invalid_ext.empty())
     {
         for (auto &f : invalid_ext)
         {
-            std::cerr << "Error: invalid extension (expected .obo): " << f << "\n";
+            std::cerr << "Error: invalid extension (expected .obo[.gz|.xz|.zst]): " << f << "\n";
         }
     }
     if (!missing.empty())
@@ -0,0 +1,409 @@
+// term_table.cpp — columnar term table + .gocache snapshot read/write
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <utility>
+#include <sys/stat.h>
+#include "term_table.hpp"
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    constexpr char kMagic[8] = {'G', 'O', 'T', 'C', 'A', 'C', 'H', 'E'};
+    constexpr std::uint32_t kVersion = 1;
+
+    // Column order inside the snapshot.
+    enum Section : std::size_t
+    {
+        kIds,
+        kNameOffsets,
+        kNameBlob,
+        kNs,
+        kNsOffsets,
+        kNsBlob,
+        kObsolete,
+        kConsiderOffsets,
+        kConsiderTargets,
+        kReplacedByOffsets,
+        kReplacedByTargets,
+        kAltIdOffsets,
+        kAltIdTargets,
+        kIsAOffsets,
+        kIsATargets,
+        kPartOfOffsets,
+        kPartOfTargets,
+        kSectionCount
+    };
+
+    struct SectionRef
+    {
+        std::uint64_t offset;
+        std::uint64_t bytes;
+    };
+
+    struct CacheHeader
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t term_count;
+        CacheKey key;
+        SectionRef sections[kSectionCount];
+    };
+
+    // 8 bytes per step; only ever compared against hashes from this same code.
+    std::uint64_t hash_bytes(std::string_view s)
+    {
+        constexpr std::uint64_t kMul = 0x9E3779B97F4A7C15ull;
+        std::uint64_t h = kMul ^ s.size();
+        std::size_t i = 0;
+        for (; i + 8 <= s.size(); i += 8)
+        {
+            std::uint64_t w;
+            std::memcpy(&w, s.data() + i, 8);
+            h = std::rotl((h ^ w) * kMul, 29);
+        }
+        std::uint64_t tail = 0;
+        std::memcpy(&tail, s.data() + i, s.size() - i);
+        h = (h ^ tail) * kMul;
+        return h ^ (h >> 32);
+    }
+
+    bool stat_source(const std::string &path, std::uint64_t &size, std::int64_t &mtime_ns)
+    {
+        struct stat st{};
+        if (::stat(path.c_str(), &st) != 0)
+            return false;
+        size = static_cast<std::uint64_t>(st.st_size);
+        mtime_ns = static_cast<std::int64_t>(st.st_mtim.tv_sec) * 1'000'000'000 + st.st_mtim.tv_nsec;
+        return true;
+    }
+
+    std::uint64_t path_hash(const std::string &path)
+    {
+        std::error_code ec;
+        const auto abs = fs::weakly_canonical(path, ec);
+        return hash_bytes(ec ? path : abs.string());
+    }
+
+    bool read_header(const std::string &cache_path, CacheHeader &h)
+    {
+        std::ifstream in(cache_path, std::ios::binary);
+        if (!in.read(reinterpret_cast<char *>(&h), sizeof h))
+            return false;
+        return std::memcmp(h.magic, kMagic, sizeof kMagic) == 0 && h.version == kVersion;
+    }
+
+    // Starts at 0, never decreases and ends at `end`, so every row lies
+    // inside the array the offsets index.
+    bool offsets_valid(const std::uint32_t *offsets, std::size_t rows, std::uint64_t end)
+    {
+        if (offsets[0] != 0 || offsets[rows] != end)
+            return false;
+        for (std::size_t i = 0; i < rows; ++i)
+            if (offsets[i] > offsets[i + 1])
+                return false;
+        return true;
+    }
+} // namespace
+
+// ---- TermTableView ----
+
+void TermTableView::load(std::size_t i, OboTerm &out) const
+{
+    out.clear();
+    out.id = id(i);
+    out.name = name(i);
+    out.ns = ns(i);
+    out.is_obsolete = is_obsolete(i);
+    auto fill = [i](const CsrView &csr, std::pmr::vector<GoId> &dst)
+    {
+        const auto row = csr.row(i);
+        dst.assign(row.begin(), row.end());
+    };
+    fill(consider, out.consider);
+    fill(replaced_by, out.replaced_by);
+    fill(alt_id, out.alt_id);
+    fill(is_a, out.is_a);
+    fill(part_of, out.part_of);
+}
+
+// ---- TermTableBuilder ----
+
+TermTableBuilder::TermTableBuilder()
+{
+    ns_code({}); // code 0 is "no namespace"
+}
+
+void TermTableBuilder::Csr::add(std::span<const GoId> row)
+{
+    targets.insert(targets.end(), row.begin(), row.end());
+    offsets.push_back(static_cast<std::uint32_t>(targets.size()));
+}
+
+void TermTableBuilder::Csr::append(const Csr &other)
+{
+    const auto base = static_cast<std::uint32_t>(targets.size());
+    targets.insert(targets.end(), other.targets.begin(), other.targets.end());
+    for (std::size_t i = 1; i < other.offsets.size(); ++i)
+        offsets.push_back(base + other.offsets[i]);
+}
+
+std::uint8_t TermTableBuilder::ns_code(std::string_view ns)
+{
+    for (std::size_t k = 0; k + 1 < ns_offsets_.size(); ++k)
+        if (std::string_view(ns_blob_).substr(ns_offsets_[k], ns_offsets_[k + 1] - ns_offsets_[k]) == ns)
+            return static_cast<std::uint8_t>(k);
+    if (ns_offsets_.size() > 256)
+        return 0; // dictionary full; GO has three namespaces
+    ns_blob_.append(ns);
+    ns_offsets_.push_back(static_cast<std::uint32_t>(ns_blob_.size()));
+    return static_cast<std::uint8_t>(ns_offsets_.size() - 2);
+}
+
+void TermTableBuilder::add(const OboTerm &t)
+{
+    const std::size_t i = ids_.size();
+    ids_.push_back(t.id);
+    name_blob_.append(t.name);
+    name_offsets_.push_back(static_cast<std::uint32_t>(name_blob_.size()));
+    ns_.push_back(ns_code(t.ns));
+    if (i % 64 == 0)
+        obsolete_.push_back(0);
+    if (t.is_obsolete)
+        obsolete_.back() |= std::uint64_t{1} << (i % 64);
+    consider_.add(t.consider);
+    replaced_by_.add(t.replaced_by);
+    alt_id_.add(t.alt_id);
+    is_a_.add(t.is_a);
+    part_of_.add(t.part_of);
+}
+
+void TermTableBuilder::append(const TermTableBuilder &other)
+{
+    const auto other_view = other.view();
+    for (std::size_t i = 0; i < other.size(); ++i)
+    {
+        const std::size_t j = ids_.size();
+        ids_.push_back(other.ids_[i]);
+        ns_.push_back(ns_code(other_view.ns(i)));
+        if (j % 64 == 0)
+            obsolete_.push_back(0);
+        if (other_view.is_obsolete(i))
+            obsolete_.back() |= std::uint64_t{1} << (j % 64);
+    }
+    const auto base = static_cast<std::uint32_t>(name_blob_.size());
+    name_blob_.append(other.name_blob_);
+    for (std::size_t i = 1; i < other.name_offsets_.size(); ++i)
+        name_offsets_.push_back(base + other.name_offsets_[i]);
+    consider_.append(other.consider_);
+    replaced_by_.append(other.replaced_by_);
+    alt_id_.append(other.alt_id_);
+    is_a_.append(other.is_a_);
+    part_of_.append(other.part_of_);
+}
+
+TermTableView TermTableBuilder::view() const
+{
+    TermTableView v;
+    v.count_ = ids_.size();
+    v.ids_ = ids_.data();
+    v.name_offsets_ = name_offsets_.data();
+    v.name_blob_ = name_blob_.data();
+    v.ns_ = ns_.data();
+    v.ns_offsets_ = ns_offsets_.data();
+    v.ns_blob_ = ns_blob_.data();
+    v.obsolete_ = obsolete_.data();
+    v.consider = {consider_.offsets.data(), consider_.targets.data()};
+    v.replaced_by = {replaced_by_.offsets.data(), replaced_by_.targets.data()};
+    v.alt_id = {alt_id_.offsets.data(), alt_id_.targets.data()};
+    v.is_a = {is_a_.offsets.data(), is_a_.targets.data()};
+    v.part_of = {part_of_.offsets.data(), part_of_.targets.data()};
+    return v;
+}
+
+bool TermTableBuilder::write_cache(const std::string &cache_path, const CacheKey &key) const
+{
+    const std::array<std::string_view, kSectionCount> columns = {
+        std::string_view(reinterpret_cast<const char *>(ids_.data()), ids_.size() * sizeof(GoId)),
+        std::string_view(reinterpret_cast<const char *>(name_offsets_.data()), name_offsets_.size() * 4),
+        std::string_view(name_blob_),
+        std::string_view(reinterpret_cast<const char *>(ns_.data()), ns_.size()),
+        std::string_view(reinterpret_cast<const char *>(ns_offsets_.data()), ns_offsets_.size() * 4),
+        std::string_view(ns_blob_),
+        std::string_view(reinterpret_cast<const char *>(obsolete_.data()), obsolete_.size() * 8),
+        std::string_view(reinterpret_cast<const char *>(consider_.offsets.data()), consider_.offsets.size() * 4),
+        std::string_view(reinterpret_cast<const char *>(consider_.targets.data()), consider_.targets.size() * sizeof(GoId)),
+        std::string_view(reinterpret_cast<const char *>(replaced_by_.offsets.data()), replaced_by_.offsets.size() * 4),
+        std::string_view(reinterpret_cast<const char *>(replaced_by_.targets.data()), replaced_by_.targets.size() * sizeof(GoId)),
+        std::string_view(reinterpret_cast<const char *>(alt_id_.offsets.data()), alt_id_.offsets.size() * 4),
+        std::string_view(reinterpret_cast<const char *>(alt_id_.targets.data()), alt_id_.targets.size() * sizeof(GoId)),
+        std::string_view(reinterpret_cast<const char *>(is_a_.offsets.data()), is_a_.offsets.size() * 4),
+        std::string_view(reinterpret_cast<const char *>(is_a_.targets.data()), is_a_.targets.size() * sizeof(GoId)),
+        std::string_view(reinterpret_cast<const char *>(part_of_.offsets.data()), part_of_.offsets.size() * 4),
+        std::string_view(reinterpret_cast<const char *>(part_of_.targets.data()), part_of_.targets.size() * sizeof(GoId)),
+    };
+
+    CacheHeader h{};
+    std::memcpy(h.magic, kMagic, sizeof kMagic);
+    h.version = kVersion;
+    h.term_count = static_cast<std::uint32_t>(ids_.size());
+    h.key = key;
+    std::uint64_t offset = sizeof h;
+    for (std::size_t s = 0; s < kSectionCount; ++s)
+    {
+        offset = (offset + 7) & ~std::uint64_t{7}; // keep every column 8-byte aligned
+        h.sections[s] = {offset, columns[s].size()};
+        offset += columns[s].size();
+    }
+
+    // Header, then padding and bytes for each column
+    std::array<std::string_view, 1 + 2 * kSectionCount> parts;
+    parts[0] = {reinterpret_cast<const char *>(&h), sizeof h};
+    std::uint64_t written = sizeof h;
+    static constexpr char kPad[8] = {};
+    for (std::size_t s = 0; s < kSectionCount; ++s)
+    {
+        parts[1 + 2 * s] = {kPad, static_cast<std::size_t>(h.sections[s].offset - written)};
+        parts[2 + 2 * s] = columns[s];
+        written = h.sections[s].offset + columns[s].size();
+    }
+    return replace_file(cache_path, parts);
+}
+
+// ---- TermCache ----
+
+bool TermCache::open(const std::string &obo_path)
+{
+    const auto path = cache_path_for(obo_path);
+    CacheHeader h;
+    if (!read_header(path, h) || !cache_key_matches(obo_path, h.key))
+        return false;
+
+    MappedFile file;
+    try
+    {
+        file = MappedFile(path);
+    }
+    catch (const std::exception &)
+    {
+        return false;
+    }
+    const auto buf = file.view();
+    for (const auto &s : h.sections)
+        if (s.offset % 8 || s.offset > buf.size() || s.bytes > buf.size() - s.offset)
+            return false; // truncated or misaligned snapshot
+
+    // Every column must have the size term_count implies, and every offset
+    // must stay inside its target array: a damaged or foreign snapshot is
+    // rejected here (and rebuilt by the caller) instead of read out of bounds.
+    auto at = [&](Section s)
+    { return buf.data() + h.sections[s].offset; };
+    auto bytes = [&](Section s)
+    { return h.sections[s].bytes; };
+    const std::size_t n = h.term_count;
+    if (bytes(kIds) != n * sizeof(GoId) || bytes(kNameOffsets) != (n + 1) * 4 || bytes(kNs) != n ||
+        bytes(kObsolete) != (n + 63) / 64 * 8 || bytes(kNsOffsets) % 4 || bytes(kNsOffsets) < 8)
+        return false;
+    constexpr std::pair<Section, Section> kCsrSections[] = {{kConsiderOffsets, kConsiderTargets},
+                                                            {kReplacedByOffsets, kReplacedByTargets},
+                                                            {kAltIdOffsets, kAltIdTargets},
+                                                            {kIsAOffsets, kIsATargets},
+                                                            {kPartOfOffsets, kPartOfTargets}};
+    for (const auto &[offsets, targets] : kCsrSections)
+        if (bytes(offsets) != (n + 1) * 4 || bytes(targets) % sizeof(GoId) ||
+            !offsets_valid(reinterpret_cast<const std::uint32_t *>(at(offsets)), n, bytes(targets) / sizeof(GoId)))
+            return false;
+    const std::size_t ns_count = bytes(kNsOffsets) / 4 - 1;
+    const auto *ns = reinterpret_cast<const std::uint8_t *>(at(kNs));
+    if (!offsets_valid(reinterpret_cast<const std::uint32_t *>(at(kNameOffsets)), n, bytes(kNameBlob)) ||
+        !offsets_valid(reinterpret_cast<const std::uint32_t *>(at(kNsOffsets)), ns_count, bytes(kNsBlob)) ||
+        std::any_of(ns, ns + n, [ns_count](std::uint8_t k)
+                    { return k >= ns_count; }))
+        return false;
+
+    file_ = std::move(file);
+    view_.count_ = n;
+    view_.ids_ = reinterpret_cast<const GoId *>(at(kIds));
+    view_.name_offsets_ = reinterpret_cast<const std::uint32_t *>(at(kNameOffsets));
+    view_.name_blob_ = at(kNameBlob);
+    view_.ns_ = reinterpret_cast<const std::uint8_t *>(at(kNs));
+    view_.ns_offsets_ = reinterpret_cast<const std::uint32_t *>(at(kNsOffsets));
+    view_.ns_blob_ = at(kNsBlob);
+    view_.obsolete_ = reinterpret_cast<const std::uint64_t *>(at(kObsolete));
+    auto csr = [&](Section offsets, Section targets) -> CsrView
+    {
+        return {reinterpret_cast<const std::uint32_t *>(at(offsets)), reinterpret_cast<const GoId *>(at(targets))};
+    };
+    view_.consider = csr(kConsiderOffsets, kConsiderTargets);
+    view_.replaced_by = csr(kReplacedByOffsets, kReplacedByTargets);
+    view_.alt_id = csr(kAltIdOffsets, kAltIdTargets);
+    view_.is_a = csr(kIsAOffsets, kIsATargets);
+    view_.part_of = csr(kPartOfOffsets, kPartOfTargets);
+    return true;
+}
+
+// ---- Keys ----
+
+std::string cache_path_for(const std::string &obo_path)
+{
+    return obo_path + ".gocache";
+}
+
+CacheKey make_cache_key(const std::string &obo_path, std::string_view contents)
+{
+    CacheKey key = stat_cache_key(obo_path);
+    key.content_hash = hash_cache_contents(contents);
+    return key;
+}
+
+CacheKey stat_cache_key(const std::string &obo_path)
+{
+    CacheKey key;
+    stat_source(obo_path, key.source_size, key.source_mtime_ns);
+    key.path_hash = path_hash(obo_path);
+    return key;
+}
+
+std::uint64_t hash_cache_contents(std::string_view contents)
+{
+    return hash_bytes(contents);
+}
+
+namespace
+{
+    // The checks that need only a stat: size and path match. same_mtime
+    // tells whether the contents can be trusted without hashing them.
+    bool stat_matches(const std::string &obo_path, const CacheKey &key, bool &same_mtime)
+    {
+        std::uint64_t size;
+        std::int64_t mtime;
+        if (!stat_source(obo_path, size, mtime) || size != key.source_size || path_hash(obo_path) != key.path_hash)
+            return false;
+        same_mtime = mtime == key.source_mtime_ns;
+        return true;
+    }
+} // namespace
+
+// Size/mtime match is trusted; a touched-but-identical file is accepted
+// after re-hashing its contents.
+bool cache_key_matches(const std::string &obo_path, const CacheKey &key)
+{
+    bool same_mtime = false;
+    if (!stat_matches(obo_path, key, same_mtime))
+        return false;
+    if (same_mtime)
+        return true;
+    const MappedFile src(obo_path);
+    return hash_bytes(src.view()) == key.content_hash;
+}
+
+bool cache_is_fresh(const std::string &obo_path)
+{
+    CacheHeader h;
+    bool same_mtime = false;
+    return read_header(cache_path_for(obo_path), h) && stat_matches(obo_path, h.key, same_mtime) && same_mtime;
+}
@@ -0,0 +1,154 @@
+#include "test_helpers.hpp"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <iostream>
+#include <iterator>
+
+int main()
+{
+    banner("Task2 consider-table & replacement resolution");
+
+    int code;
+    // consider cycle with a way out: both members resolve to the live term, in either ID order
+    auto out = run_capture("./task2 --resolve-replacements test/data/consider_cycle.obo --no-cache", code);
+    assert_contains(out, "GO:0000001\tresolved\tGO:0000003\n", "Task2 cycle member reaching a live term (lower ID)");
+    assert_contains(out, "GO:0000002\tresolved\tGO:0000003\n", "Task2 cycle member with the live consider (higher ID)");
+    assert_contains(out, "GO:0000011\tresolved\tGO:0000013\n", "Task2 cycle member with the live consider (lower ID)");
+    assert_contains(out, "GO:0000012\tresolved\tGO:0000013\n", "Task2 cycle member reaching a live term (higher ID)");
+    // a loop with no way out stays a cycle
+    assert_contains(out, "GO:0000021\tcycle\t\nGO:0000022\tcycle\t\n", "Task2 closed consider loop");
+    // --output takes the same rows, and rejects paths without .tab
+    const auto tab = run_capture("./task2 --resolve-replacements test/data/consider_cycle.obo --no-cache --output resolve_test.tab"
+                                 " && cat resolve_test.tab; rm -f resolve_test.tab", code);
+    assert_true(tab == out, "Task2 resolve-replacements to --output");
+    out = run_capture("./task2 --diff-releases test/data/names.obo test/data/consider_cycle.obo --no-cache --output diff.txt 2>&1", code);
+    assert_contains(out, "--output must end with .tab", "Task2 diff-releases rejects non-.tab output");
+
+    // diff-releases: every change kind, by ID; an obsolescence change plus a
+    // namespace move is two rows, a term dropped or arriving live is none
+    out = run_capture("./task2 --diff-releases test/data/release_a.obo test/data/release_b.obo --no-cache", code);
+    const std::string pair = "test/data/release_a.obo\ttest/data/release_b.obo\t";
+    assert_true(out == "from\tto\tchange\tid\tbefore\tafter\n" +
+                           pair + "obsoleted\tGO:0000101\t\treplaced_by=GO:0000105;consider=\n" +
+                           pair + "revived\tGO:0000102\treplaced_by=;consider=GO:0000105\t\n" +
+                           pair + "alternatives_changed\tGO:0000103\treplaced_by=;consider=GO:0000105\treplaced_by=GO:0000105;consider=GO:0000104\n" +
+                           pair + "namespace_moved\tGO:0000104\tmolecular_function\tbiological_process\n" +
+                           pair + "obsoleted\tGO:0000106\t\treplaced_by=;consider=GO:0000104\n" +
+                           pair + "namespace_moved\tGO:0000106\tmolecular_function\tcellular_component\n" +
+                           pair + "obsoleted\tGO:0000107\t\treplaced_by=;consider=GO:0000105\n",
+                "Task2 diff-releases change kinds");
+    // The namespace filter applies to the newer release
+    out = run_capture("./task2 --diff-releases test/data/release_a.obo test/data/release_b.obo --no-cache --namespace cellular_component", code);
+    assert_true(out == "from\tto\tchange\tid\tbefore\tafter\n" +
+                           pair + "obsoleted\tGO:0000106\t\treplaced_by=;consider=GO:0000104\n" +
+                           pair + "namespace_moved\tGO:0000106\tmolecular_function\tcellular_component\n",
+                "Task2 diff-releases namespace filter on the newer release");
+
+    // BGZF input (five blocks): same rows, and --no-cache leaves no .gzi behind
+    const auto bgzf = run_capture("rm -f test/data/consider_cycle.obo.gz.gzi; ./task2 --resolve-replacements test/data/consider_cycle.obo.gz --no-cache", code);
+    assert_true(bgzf == tab, "Task2 BGZF input matches plain");
+    run_capture("test -e test/data/consider_cycle.obo.gz.gzi", code);
+    assert_true(code != 0, "Task2 --no-cache writes no .gzi");
+
+    // Malformed BGZF members are rejected before anything is inflated
+    {
+        // XLEN 24 (a "BC" subfield plus 18 bytes of another) in a 40-byte
+        // member: the extra field runs into the CRC32/ISIZE trailer.
+        std::string overlap = std::string("\x1f\x8b\x08\x04\0\0\0\0\0\xff\x18\0BC\x02\0\x27\0XX\x0e\0", 22);
+        overlap.resize(40, '\0');
+        std::ofstream("bgzf_overlap.obo.gz", std::ios::binary) << overlap;
+        // First member of the fixture, with ISIZE claiming 1 GiB.
+        std::ifstream in("test/data/consider_cycle.obo.gz", std::ios::binary);
+        std::string member(std::istreambuf_iterator<char>(in), {});
+        member.resize(std::size_t(std::uint8_t(member[16])) + (std::size_t(std::uint8_t(member[17])) << 8) + 1);
+        member.replace(member.size() - 4, 4, std::string("\0\0\0\x40", 4));
+        std::ofstream("bgzf_isize.obo.gz", std::ios::binary) << member;
+    }
+    for (const std::string f : {"bgzf_overlap.obo.gz", "bgzf_isize.obo.gz"})
+    {
+        out = run_capture("./task2 --consider-table " + f + " --no-cache 2>&1; s=$?; rm -f " + f + "; exit $s", code);
+        assert_contains(out, "bgzf: malformed block at byte 0", "Task2 rejects " + f);
+        assert_true(code != 0, "Task2 exit status for " + f);
+    }
+
+    // gzip and xz inputs are streamed: same rows as the plain file
+    const auto plain = run_capture("./task2 --consider-table test/data/names.obo --no-cache", code);
+    for (const std::string f : {"test/data/names.obo.gz", "test/data/names.obo.xz"})
+    {
+        out = run_capture("./task2 --consider-table " + f + " --no-cache", code);
+        assert_true(code == 0 && out == plain, "Task2 " + f + " matches plain");
+    }
+    // A truncated archive is an error, not a short table
+    for (const std::string ext : {"gz", "xz"})
+    {
+        const std::string f = "truncated.obo." + ext;
+        out = run_capture("head -c 100 test/data/names.obo." + ext + " > " + f +
+                              "; ./task2 --consider-table " + f + " --no-cache 2>&1; s=$?; rm -f " + f + "; exit $s",
+                          code);
+        assert_contains(out, "truncated", "Task2 truncated ." + ext + " reported");
+        assert_true(code != 0, "Task2 truncated ." + ext + " exit status");
+    }
+
+    // Over several 4 MiB ring blocks: the first block ends between the "\n"
+    // and the "[" of a stanza header, the second ends inside a stanza.
+    {
+        constexpr std::size_t kBlock = std::size_t{4} << 20;
+        auto stanza = [](std::size_t i)
+        {
+            return "\n[Term]\nid: GO:" + std::to_string(1000000 + i) + "\nname: generated term\n"
+                   "namespace: molecular_function\nis_obsolete: true\nconsider: GO:" + std::to_string(1000001 + i) + "\n";
+        };
+        const std::size_t len = stanza(0).size();
+        std::string obo = "format-version: 1.2\nremark: ";
+        obo.append((kBlock - 1 - obo.size() - 1) % len, 'x').append("\n"); // stanzas start at kBlock - 1 - k * len
+        std::size_t terms = 0;
+        while (obo.size() < 2 * kBlock + kBlock / 2)
+            obo += stanza(terms++);
+        assert_true(obo.compare(kBlock - 1, 2, "\n[") == 0 && obo.compare(2 * kBlock - 1, 2, "\n[") != 0,
+                    "Task2 generated input splits where intended");
+        std::ofstream("blocks.obo", std::ios::binary) << obo;
+    }
+    const auto rows = run_capture("./task2 --consider-table blocks.obo --no-cache", code);
+    out = run_capture("gzip -c blocks.obo > blocks.obo.gz && ./task2 --consider-table blocks.obo.gz --no-cache;"
+                      " s=$?; rm -f blocks.obo blocks.obo.gz; exit $s",
+                      code);
+    assert_true(code == 0 && out == rows, "Task2 stanzas carried across ring blocks");
+    assert_contains(rows, "GO:1000000\tGO:1000001\t\n", "Task2 generated input parsed");
+
+    // --pattern escapes: hex digits and backreferences are not required literals
+    out = run_capture("./task2 --consider-table test/data/names.obo --no-cache --pattern 'obsolete \\x64ead'", code);
+    assert_contains(out, "GO:0000005\tGO:0000006", "Task2 pattern with a \\x escape");
+    out = run_capture("./task2 --consider-table test/data/names.obo --no-cache --pattern '(d)ea\\1 end'", code);
+    assert_contains(out, "GO:0000005\tGO:0000006", "Task2 pattern with a backreference");
+    assert_true(out.find("GO:0000007") == std::string::npos, "Task2 escaped pattern still filters");
+
+    // A failed write is reported, not just an exit status
+    out = run_capture("./task2 --consider-table test/data/names.obo --no-cache 2>&1 >/dev/full", code);
+    assert_contains(out, "Error: cannot write standard output: No space left on device", "Task2 write error reported");
+    assert_true(code != 0, "Task2 write error exit status");
+
+    // A damaged .gocache is rejected and rebuilt, not read out of bounds
+    run_capture("cp test/data/consider_cycle.obo cache_test.obo && rm -f cache_test.obo.gocache"
+                " && ./task2 --resolve-replacements cache_test.obo", code);
+    {
+        // Header: term_count at byte 12, 16-byte section refs from byte 48;
+        // section 7 holds the consider offsets. Point the last one far away.
+        std::fstream cache("cache_test.obo.gocache", std::ios::in | std::ios::out | std::ios::binary);
+        std::uint32_t terms = 0;
+        std::uint64_t offsets = 0;
+        cache.seekg(12).read(reinterpret_cast<char *>(&terms), sizeof terms);
+        cache.seekg(48 + 7 * 16).read(reinterpret_cast<char *>(&offsets), sizeof offsets);
+        const std::uint32_t bad = 0x7fffffff;
+        cache.seekp(static_cast<std::streamoff>(offsets + 4 * terms)).write(reinterpret_cast<const char *>(&bad), sizeof bad);
+        assert_true(static_cast<bool>(cache), "Task2 cache patched");
+    }
+    const auto fresh = run_capture("./task2 --resolve-replacements cache_test.obo --no-cache", code);
+    out = run_capture("./task2 --resolve-replacements cache_test.obo", code);
+    assert_true(code == 0 && out == fresh, "Task2 damaged cache rebuilt");
+    out = run_capture("./task2 --resolve-replacements cache_test.obo; rm -f cache_test.obo cache_test.obo.gocache", code);
+    assert_true(out == fresh, "Task2 rebuilt cache reused");
+
+    std::cout << "Task2 tests passed.\n";
+    return 0;
+}
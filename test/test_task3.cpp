@@ -0,0 +1,176 @@
+#include "test_helpers.hpp"
+#include <chrono>
+#include <string>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// A connection to the server, retried while it is still loading.
+static int connect_to(const std::string &socket_path)
+{
+    for (int attempt = 0; attempt < 100; ++attempt)
+    {
+        const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        socket_path.copy(addr.sun_path, sizeof addr.sun_path - 1);
+        if (::connect(fd, reinterpret_cast<const sockaddr *>(&addr), sizeof addr) == 0)
+            return fd;
+        ::close(fd);
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    throw std::runtime_error("cannot connect to " + socket_path);
+}
+
+// Sends requests on one connection and returns everything the server
+// writes until it closes the connection (after QUIT or an error).
+static std::string query(const std::string &socket_path, const std::string &requests)
+{
+    const int fd = connect_to(socket_path);
+    std::string reply;
+    if (::send(fd, requests.data(), requests.size(), MSG_NOSIGNAL) == static_cast<ssize_t>(requests.size()))
+    {
+        char buf[4096];
+        for (ssize_t n; (n = ::recv(fd, buf, sizeof buf, 0)) > 0;)
+            reply.append(buf, static_cast<std::size_t>(n));
+    }
+    ::close(fd);
+    return reply;
+}
+
+// Sends one request on an open connection and reads its whole reply:
+// the status line, plus n lines after "OK n".
+static std::string request(int fd, const std::string &line)
+{
+    const std::string msg = line + "\n";
+    if (::send(fd, msg.data(), msg.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(msg.size()))
+        return {};
+    std::string reply;
+    std::size_t lines = 0, want = 1;
+    for (char c; lines < want && ::recv(fd, &c, 1, 0) == 1;)
+    {
+        reply += c;
+        if (c == '\n' && ++lines == 1 && reply.starts_with("OK "))
+            want += std::stoul(reply.substr(3));
+    }
+    return reply;
+}
+
+// Starts a server in the background; returns its pid.
+static std::string start_server(const std::string &sock, const std::string &args)
+{
+    int code;
+    auto pid = run_capture("rm -f " + sock + "; ./task3 --serve " + sock + " " + args + " >/dev/null 2>&1 & echo $!", code);
+    pid.pop_back(); // newline
+    return pid;
+}
+
+int main()
+{
+    banner("Task3 server graph queries");
+
+    int code;
+    const std::string sock = "test_task3.sock";
+    auto pid = start_server(sock, "test/data/graph.obo --no-cache --threads 4");
+
+    // Ancestors over both relations, with depths, by ID; an alt_id answers for its term
+    const std::string leaf = "OK 4\nGO:0000100\t0\nGO:0000101\t1\nGO:0000102\t1\nGO:0000103\t2\n";
+    auto out = query(sock, "ANCESTORS GO:0000104\nANCESTORS GO:0000199\nQUIT\n");
+    assert_true(out == leaf + leaf, "Task3 ANCESTORS of a leaf and of its alt_id");
+
+    // relation= keeps only the named edge type
+    out = query(sock, "ANCESTORS GO:0000104 relation=is_a\nDESCENDANTS GO:0000102\n"
+                      "DESCENDANTS GO:0000102 relation=is_a\nANCESTORS GO:0000100\nQUIT\n");
+    assert_contains(out, "OK 3\nGO:0000100\t0\nGO:0000101\t1\nGO:0000103\t2\n", "Task3 ANCESTORS over is_a only");
+    assert_contains(out, "OK 2\nGO:0000103\t2\nGO:0000104\t3\nOK 0\nOK 0\n", "Task3 DESCENDANTS over both relations and is_a only");
+    out = query(sock, "ANCESTORS GO:0000104 relation=regulates\nQUIT\n");
+    assert_contains(out, "ERR unknown relation regulates", "Task3 unknown relation rejected");
+
+    // Concurrent connections share the closure cache and see the same answers
+    std::vector<std::string> replies(4);
+    std::vector<std::thread> clients;
+    for (std::size_t c = 0; c < replies.size(); ++c)
+        clients.emplace_back([&, c]
+                             {
+            std::string requests;
+            for (int k = 0; k < 50; ++k)
+                requests += k % 2 ? "ANCESTORS GO:0000104\n" : "DESCENDANTS GO:0000100\n";
+            replies[c] = query(sock, requests + "QUIT\n"); });
+    for (auto &t : clients)
+        t.join();
+    std::string expected;
+    for (int k = 0; k < 50; ++k)
+        expected += k % 2 ? leaf : "OK 4\nGO:0000101\t1\nGO:0000102\t1\nGO:0000103\t2\nGO:0000104\t3\n";
+    for (const auto &r : replies)
+        assert_true(r == expected, "Task3 concurrent graph queries");
+
+    run_capture("kill " + pid + "; rm -f " + sock, code);
+
+    // One worker: an idle connection does not hold it, and an over-long line gets ERR
+    pid = start_server(sock, "test/data/graph.obo --no-cache --threads 1");
+    const int idle = connect_to(sock);
+    out = query(sock, "PING\nQUIT\n");
+    assert_true(out == "OK 0\n", "Task3 idle connection leaves the worker free");
+    out = query(sock, "LOOKUP " + std::string(70000, 'x') + "\nPING\n");
+    assert_contains(out, "ERR request line longer than 65536 bytes\n", "Task3 request line cap");
+    assert_true(out.find("OK") == std::string::npos, "Task3 connection closed after an over-long line");
+    ::close(idle);
+    run_capture("kill " + pid + "; rm -f " + sock, code);
+
+    // Hot reload: a release renamed over the served file is picked up once it
+    // has been quiet for kReloadQuietMs, and a connection opened before the
+    // swap keeps being answered (from the new snapshot)
+    // (its own socket: the server killed above unlinks its path on the way out)
+    const std::string reload_sock = "test_reload.sock";
+    run_capture("cp test/data/names.obo reload.obo", code);
+    pid = start_server(reload_sock, "reload.obo --no-cache --threads 2");
+    const int before = connect_to(reload_sock);
+    out = request(before, "LOOKUP GO:0000006");
+    assert_true(out == "OK 1\nGO:0000006\tlive replacement\tmolecular_function\tlive\treplaced_by=;consider=\n",
+                "Task3 LOOKUP before reload");
+    run_capture("sed 's/^name: live replacement$/name: retired replacement\\nis_obsolete: true\\nreplaced_by: GO:0000005/' "
+                "reload.obo > reload.obo.new && mv reload.obo.new reload.obo", code);
+    const std::string reloaded = "OK 1\nGO:0000006\tretired replacement\tmolecular_function\tobsolete\treplaced_by=GO:0000005;consider=\n";
+    for (int attempt = 0; attempt < 50 && out != reloaded; ++attempt)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        out = query(reload_sock, "LOOKUP GO:0000006\nQUIT\n");
+    }
+    assert_true(out == reloaded, "Task3 LOOKUP sees the renamed release");
+    assert_true(request(before, "LOOKUP GO:0000006") == reloaded, "Task3 connection from before the swap still answered");
+    assert_true(request(before, "PING") == "OK 0\n", "Task3 connection from before the swap still open");
+    ::close(before);
+    run_capture("kill " + pid + "; rm -f " + reload_sock + " reload.obo", code);
+
+    // --time-series: one row per (release, namespace), cached per release as .gostats only
+    run_capture("rm -f ts_a.obo* ts_b.obo*; cp test/data/names.obo ts_a.obo; cp test/data/consider_cycle.obo ts_b.obo", code);
+    out = run_capture("./task3 --time-series ts_a.obo ts_b.obo", code);
+    assert_true(out == "release\tnamespace\tobsolete_total\twith_alternatives\twith_replaced_by\tconsider_only\tno_alternative\n"
+                       "ts_a.obo\tall\t2\t2\t0\t2\t0\n"
+                       "ts_a.obo\tmolecular_function\t2\t2\t0\t2\t0\n"
+                       "ts_b.obo\tall\t6\t6\t0\t6\t0\n"
+                       "ts_b.obo\tbiological_process\t2\t2\t0\t2\t0\n"
+                       "ts_b.obo\tcellular_component\t2\t2\t0\t2\t0\n"
+                       "ts_b.obo\tmolecular_function\t2\t2\t0\t2\t0\n",
+                "Task3 time-series rows");
+    out = run_capture("ls ts_a.obo.gostats ts_b.obo.gostats ts_a.obo.gocache ts_b.obo.gocache 2>/dev/null", code);
+    assert_true(out == "ts_a.obo.gostats\nts_b.obo.gostats\n", "Task3 time-series writes .gostats and no .gocache");
+
+    // Plant totals in both caches: a second run reports them, so nothing was re-parsed
+    run_capture("sed -i 's/^all\\t2\\t/all\\t20\\t/' ts_a.obo.gostats; sed -i 's/^all\\t6\\t/all\\t60\\t/' ts_b.obo.gostats", code);
+    out = run_capture("./task3 --time-series ts_a.obo ts_b.obo", code);
+    assert_contains(out, "ts_a.obo\tall\t20\t", "Task3 time-series served from .gostats (first release)");
+    assert_contains(out, "ts_b.obo\tall\t60\t", "Task3 time-series served from .gostats (second release)");
+
+    // An edited release is recomputed; the other keeps its cached entry
+    run_capture("printf '\\n[Term]\\nid: GO:0000008\\nname: obsolete extra\\nnamespace: molecular_function\\nis_obsolete: true\\n' >> ts_a.obo", code);
+    out = run_capture("./task3 --time-series ts_a.obo ts_b.obo; rm -f ts_a.obo* ts_b.obo*", code);
+    assert_contains(out, "ts_a.obo\tall\t3\t2\t0\t2\t1\n", "Task3 time-series edited release recomputed");
+    assert_contains(out, "ts_b.obo\tall\t60\t", "Task3 time-series untouched release still cached");
+
+    std::cout << "Task3 tests passed.\n";
+    return 0;
+}